@@ -68,60 +68,25 @@ streamed piece by piece.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
 static ClownResampler_LowLevel_State resampler;
 static unsigned int total_channels;
 static drmp3_int16 *resampler_input_buffer;
 static size_t resampler_input_buffer_total_frames;
-static size_t resampler_input_buffer_frames_remaining;
-
-typedef struct ResamplerCallbackData
-{
-	ma_int16 *output_pointer;
-	ma_uint32 output_buffer_frames_remaining;
-} ResamplerCallbackData;
-
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
-{
-	ResamplerCallbackData* const callback_data = (ResamplerCallbackData*)user_data;
-
-	cc_u8f i;
-
-	/* Output the frame. */
-	for (i = 0; i < total_samples; ++i)
-	{
-		cc_s32f sample;
-
-		sample = frame[i];
-
-		/* Clamp the sample to 16-bit. */
-		if (sample > 0x7FFF)
-			sample = 0x7FFF;
-		else if (sample < -0x7FFF)
-			sample = -0x7FFF;
-
-		/* Push the sample to the output buffer. */
-		*callback_data->output_pointer++ = (ma_int16)sample;
-	}
-
-	/* Signal whether there is more room in the output buffer. */
-	return --callback_data->output_buffer_frames_remaining != 0;
-}
 
 static void AudioCallback(ma_device *device, void *output, const void *input, ma_uint32 frame_count)
 {
-	ResamplerCallbackData callback_data;
+	size_t frames_done;
 
 	(void)device;
 	(void)input;
 
-	callback_data.output_pointer = (ma_int16*)output;
-	callback_data.output_buffer_frames_remaining = frame_count;
-
-	/* Resample the decoded audio data. */
-	ClownResampler_LowLevel_Resample(&resampler, &precomputed, &resampler_input_buffer[(resampler_input_buffer_total_frames - resampler_input_buffer_frames_remaining) * total_channels], &resampler_input_buffer_frames_remaining, ResamplerOutputCallback, &callback_data);
+	/* Resample the decoded audio data straight into the output buffer. */
+	/* The input buffer has no padding, so the unpadded function is used, which keeps track of its position in the buffer by itself. */
+	frames_done = ClownResampler_LowLevel_ResampleUnpaddedToS16(&resampler, &precomputed, resampler_input_buffer, resampler_input_buffer_total_frames, (cc_s16l*)output, frame_count);
 
 	/* If there are no more samples left, then fill the remaining space in the buffer with 0. */
-	memset(callback_data.output_pointer, 0, callback_data.output_buffer_frames_remaining * total_channels * sizeof(ma_int16));
+	memset((ma_int16*)output + frames_done * total_channels, 0, (frame_count - frames_done) * total_channels * sizeof(ma_int16));
 }
 
 int main(int argc, char **argv)
@@ -184,11 +149,11 @@ int main(int argc, char **argv)
 				/******************************/
 
 				/* Precompute the Lanczos kernel. */
-				ClownResampler_Precompute(&precomputed);
+				ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
 
 				/* Create a resampler that converts from the sample rate of the MP3 to the sample rate of the playback device. */
 				/* The low-pass filter is set to 44100Hz since that should allow all human-perceivable frequencies through. */
-				ClownResampler_LowLevel_Init(&resampler, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
+				ClownResampler_LowLevel_Init(&resampler, &precomputed, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
 
 				/*****************************************/
 				/* Finished initialising clownresampler. */
@@ -199,8 +164,8 @@ int main(int argc, char **argv)
 				/*****************************************/
 
 				/* Create a buffer to hold the decoded PCM data. */
-				/* clownresampler's low-level API requires that this buffer have padding at its beginning and end. */
-				resampler_input_buffer = (drmp3_int16*)malloc((resampler.lowest_level.integer_stretched_kernel_radius * 2 + total_mp3_pcm_frames) * size_of_frame);
+				/* Since the unpadded functions are used, this buffer does not need any padding at its beginning or end. */
+				resampler_input_buffer = (drmp3_int16*)malloc(total_mp3_pcm_frames * size_of_frame);
 
 				if (resampler_input_buffer == NULL)
 				{
@@ -209,18 +174,12 @@ int main(int argc, char **argv)
 				}
 				else
 				{
-					/* Set the padding samples at the start to 0. */
-					memset(&resampler_input_buffer[0], 0, resampler.lowest_level.integer_stretched_kernel_radius * size_of_frame);
-
 					/* Decode the MP3 to the input buffer. */
-					drmp3_read_pcm_frames_s16(&mp3_decoder, total_mp3_pcm_frames, &resampler_input_buffer[resampler.lowest_level.integer_stretched_kernel_radius * total_channels]);
+					drmp3_read_pcm_frames_s16(&mp3_decoder, total_mp3_pcm_frames, resampler_input_buffer);
 					drmp3_uninit(&mp3_decoder);
 
-					/* Set the padding samples at the end to 0. */
-					memset(&resampler_input_buffer[(resampler.lowest_level.integer_stretched_kernel_radius + total_mp3_pcm_frames) * total_channels], 0, resampler.lowest_level.integer_stretched_kernel_radius * size_of_frame);
-
 					/* Initialise some variables that will be used by the audio callback. */
-					resampler_input_buffer_total_frames = resampler_input_buffer_frames_remaining = total_mp3_pcm_frames;
+					resampler_input_buffer_total_frames = total_mp3_pcm_frames;
 
 					/*****************************************************/
 					/* Finished setting up the resampler's input buffer. */
@@ -280,16 +239,11 @@ streamed piece by piece.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
 static ClownResampler_HighLevel_State resampler;
 static drmp3 mp3_decoder;
 static unsigned int total_channels;
 
-typedef struct ResamplerCallbackData
-{
-	ma_int16 *output_pointer;
-	ma_uint32 output_buffer_frames_remaining;
-} ResamplerCallbackData;
-
 static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
 {
 	(void)user_data;
@@ -298,48 +252,18 @@ static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t to
 	return drmp3_read_pcm_frames_s16(&mp3_decoder, total_frames, buffer);
 }
 
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
-{
-	ResamplerCallbackData* const callback_data = (ResamplerCallbackData*)user_data;
-
-	cc_u8f i;
-
-	/* Output the frame. */
-	for (i = 0; i < total_samples; ++i)
-	{
-		cc_s32f sample;
-
-		sample = frame[i];
-
-		/* Clamp the sample to 16-bit. */
-		if (sample > 0x7FFF)
-			sample = 0x7FFF;
-		else if (sample < -0x7FFF)
-			sample = -0x7FFF;
-
-		/* Push the sample to the output buffer. */
-		*callback_data->output_pointer++ = (ma_int16)sample;
-	}
-
-	/* Signal whether there is more room in the output buffer. */
-	return --callback_data->output_buffer_frames_remaining != 0;
-}
-
 static void AudioCallback(ma_device *device, void *output, const void *input, ma_uint32 frame_count)
 {
-	ResamplerCallbackData callback_data;
+	size_t frames_done;
 
 	(void)device;
 	(void)input;
 
-	callback_data.output_pointer = (ma_int16*)output;
-	callback_data.output_buffer_frames_remaining = frame_count;
-
-	/* Resample the decoded audio data. */
-	ClownResampler_HighLevel_Resample(&resampler, &precomputed, ResamplerInputCallback, ResamplerOutputCallback, &callback_data);
+	/* Resample the decoded audio data straight into the output buffer. */
+	frames_done = ClownResampler_HighLevel_ResampleToS16(&resampler, &precomputed, ResamplerInputCallback, (cc_s16l*)output, frame_count, NULL);
 
 	/* If there are no more samples left, then fill the remaining space in the buffer with 0. */
-	memset(callback_data.output_pointer, 0, callback_data.output_buffer_frames_remaining * total_channels * sizeof(ma_int16));
+	memset((ma_int16*)output + frames_done * total_channels, 0, (frame_count - frames_done) * total_channels * sizeof(ma_int16));
 }
 
 int main(int argc, char **argv)
@@ -393,11 +317,11 @@ int main(int argc, char **argv)
 				/******************************/
 
 				/* Precompute the Lanczos kernel. */
-				ClownResampler_Precompute(&precomputed);
+				ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
 
 				/* Create a resampler that converts from the sample rate of the MP3 to the sample rate of the playback device. */
 				/* The low-pass filter is set to 44100Hz since that should allow all human-perceivable frequencies through. */
-				ClownResampler_HighLevel_Init(&resampler, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
+				ClownResampler_HighLevel_Init(&resampler, &precomputed, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
 
 				/*****************************************/
 				/* Finished initialising clownresampler. */
@@ -440,15 +364,18 @@ int main(int argc, char **argv)
  #endif
 #endif
 
-/* Controls the number of 'lobes' of the windowed sinc function.
-   A higher number results in better audio, but is more expensive. */
+/* The default number of 'lobes' of the windowed sinc function.
+   A higher number results in better audio, but is more expensive.
+   The number that is actually used is chosen at runtime, when calling
+   'ClownResampler_Precompute': this is merely a sensible default. */
 #ifndef CLOWNRESAMPLER_KERNEL_RADIUS
 #define CLOWNRESAMPLER_KERNEL_RADIUS 3
 #endif
 
-/* How many samples to render per lobe for the pre-computed Lanczos kernel.
-   Higher numbers produce a higher-quality Lanczos kernel, but cause it to take
-   up more memory and cache. */
+/* The default number of samples to render per lobe for the pre-computed
+   Lanczos kernel. Higher numbers produce a higher-quality Lanczos kernel, but
+   cause it to take up more memory and cache. As with
+   'CLOWNRESAMPLER_KERNEL_RADIUS', this is chosen at runtime. */
 #ifndef CLOWNRESAMPLER_KERNEL_RESOLUTION
 #define CLOWNRESAMPLER_KERNEL_RESOLUTION 0x400 /* 1024 samples per lobe should be more than good enough */
 #endif
@@ -459,6 +386,165 @@ int main(int argc, char **argv)
 #define CLOWNRESAMPLER_MAXIMUM_CHANNELS 16 /* As stb_vorbis says, this should be enough for pretty much everyone. */
 #endif
 
+/* Enables the polyphase filter-bank. When the input and output sample rates
+   reduce to a small ratio (for example, 44100 and 48000 reduce to 147 and
+   160), a set of pre-normalised coefficients is generated for each output
+   phase, allowing each frame to be resampled with a plain dot-product instead
+   of by stepping through the Lanczos kernel. The filter-bank is stored in a
+   buffer that is given to the resampler with
+   'ClownResampler_LowLevel_SetPolyphaseBank' or
+   'ClownResampler_HighLevel_SetPolyphaseBank': resamplers that are not given
+   one use the regular kernel. */
+/*#define CLOWNRESAMPLER_POLYPHASE*/
+
+/* A suitable number of coefficients for a polyphase filter-bank's buffer.
+   Ratios which would need more coefficients than the buffer holds fall back
+   on the regular kernel. */
+#ifndef CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS
+#define CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS 0x1000
+#endif
+
+/* The number of positions between two output frames that the band-limited
+   step API can place a step at. Steps are rounded to the nearest of these. */
+#ifndef CLOWNRESAMPLER_STEP_PHASES
+#define CLOWNRESAMPLER_STEP_PHASES 0x40
+#endif
+
+/* The maximum number of coefficients in the band-limited step API's
+   filter-bank, which holds a step for each phase. Kernels that are stretched
+   so much that they would need more coefficients than this are not supported.
+   This affects the size of 'ClownResampler_Step_State'. */
+#ifndef CLOWNRESAMPLER_STEP_MAXIMUM_COEFFICIENTS
+#define CLOWNRESAMPLER_STEP_MAXIMUM_COEFFICIENTS 0x800
+#endif
+
+/* Makes the high-level API split large downsampling ratios into stages. The
+   cost of the Lanczos kernel grows with its scale (the ratio of the input
+   sample rate to the lower of the output and low-pass filter sample rates), so
+   when the scale is above 'CLOWNRESAMPLER_DECIMATION_THRESHOLD', the input is
+   first reduced by a series of cheap 2:1 decimation stages, until the scale
+   that is left for the Lanczos kernel is no higher than the threshold. This
+   also allows ratios that are too large for the low-level API to be used.
+   Each stage is a 15-tap maximally-flat half-band filter, which attenuates
+   everything that would alias into the passband by more than 80dB. The
+   output for ratios above the threshold is not the same as without this. */
+/*#define CLOWNRESAMPLER_DECIMATION_STAGES*/
+
+/* The kernel scale above which the decimation stages (or the CIC filter) are
+   used. */
+#ifndef CLOWNRESAMPLER_DECIMATION_THRESHOLD
+#define CLOWNRESAMPLER_DECIMATION_THRESHOLD 8
+#endif
+
+/* The maximum number of 2:1 decimation stages that the high-level API can
+   use. Each stage makes 'ClownResampler_HighLevel_State' larger. */
+#ifndef CLOWNRESAMPLER_MAXIMUM_DECIMATION_STAGES
+#define CLOWNRESAMPLER_MAXIMUM_DECIMATION_STAGES 12
+#endif
+
+/* The 64-bit signed integer type that 'CLOWNRESAMPLER_WIDE_ACCUMULATOR' uses.
+   C89 does not have one, so, if this is not defined, then 'long long' is used
+   with C99, C++11, GCC, and Clang, and '__int64' is used with MSVC. Any other
+   compiler must have this defined for it. */
+/*#define CLOWNRESAMPLER_WIDE_ACCUMULATOR_TYPE long long*/
+
+/* Like 'CLOWNRESAMPLER_DECIMATION_STAGES', but makes the high-level API
+   decimate with a single third-order cascaded integrator-comb (CIC) filter
+   instead of a series of 2:1 half-band filters. This takes priority over
+   'CLOWNRESAMPLER_DECIMATION_STAGES'.
+   A CIC filter can decimate by any whole number up to 40 and costs only a few
+   additions per input frame, which suits extremely high input sample rates,
+   such as the master clock rate of an emulated sound chip. Its nulls fall on
+   the frequencies that would alias into the passband, but it attenuates the
+   frequencies around those nulls less than the half-band filters do. The
+   droop that it causes near the top of the passband is corrected by a small
+   filter after it. */
+/*#define CLOWNRESAMPLER_CIC_DECIMATOR*/
+
+/* Makes 'ClownResampler_Precomputed' store only one half of the Lanczos kernel,
+   relying on the kernel being symmetrical. This halves the size of the table,
+   so that it takes up less cache, at the cost of each frame's convolution being
+   split in two. */
+/*#define CLOWNRESAMPLER_SYMMETRIC_KERNEL*/
+
+/* Makes the resampler linearly interpolate between the entries of the
+   precomputed Lanczos kernel, instead of using whichever entry is nearest.
+   This allows the kernel resolution to be lowered considerably
+   (to 0x80 or 0x100, for instance) without harming the audio quality, so that
+   the table can fit in the CPU's L1 cache. */
+/*#define CLOWNRESAMPLER_INTERPOLATE_KERNEL*/
+
+/* Makes the convolution add up the full products of the samples and the kernel
+   in 64-bit accumulators, instead of rounding each product down to 16 bits and
+   adding them up in 32 bits. The rounding is then done only once per frame,
+   together with the normalisation, so the output is slightly more accurate.
+   The SIMD routines for this require SSE4.1 or AVX2. This needs a 64-bit
+   integer type, which C89 lacks: see 'CLOWNRESAMPLER_WIDE_ACCUMULATOR_TYPE'. */
+/*#define CLOWNRESAMPLER_WIDE_ACCUMULATOR*/
+
+/* Makes every output frame use the same number of taps: twice the stretched
+   kernel radius, rounded up. Normally, the taps that fall outside of the kernel
+   are skipped, so the number of them changes from frame to frame. Instead, the
+   kernel table is padded with silence at both ends, which the taps outside of
+   the kernel land in. This gives the convolution a loop that always runs the
+   same number of times for a given configuration. The window also includes a
+   few taps at the edges of the kernel that would otherwise be skipped, so the
+   output is slightly more accurate, but not the same as without this. The
+   kernel is also centred on the position plus the stretched kernel radius
+   rounded up, rather than plus the exact stretched kernel radius, so the output
+   is delayed by the fraction of a frame that the radius was rounded up by
+   ('stretched_kernel_radius_delta'). This is zero when the kernel is not
+   stretched, such as when upsampling. This has no effect when
+   'CLOWNRESAMPLER_SYMMETRIC_KERNEL' or 'CLOWNRESAMPLER_INTERPOLATE_KERNEL' are
+   defined. */
+/*#define CLOWNRESAMPLER_FIXED_TAPS*/
+
+/* Stores the kernel as 16-bit values in Q1.15 fixed point, instead of 32-bit
+   values in 16.16 fixed point, which halves the size of the kernel table. The
+   table must then be declared as an array of 'ClownResampler_KernelValue'
+   rather than 'cc_s32l'. The SIMD routines multiply pairs of samples by pairs
+   of kernel values and add the products together with a single instruction
+   ('pmaddwd'), so each instruction does twice as many taps. The kernel values
+   are still gathered into the vectors one at a time, since consecutive taps
+   are a stretched step apart in the table, so the loads are not any faster
+   than with 32-bit values: only the multiplications are. The kernel loses a
+   bit of precision, and its peak is clamped to just below 1.0, so the output
+   is not quite the same as without this. This cannot be combined with
+   'CLOWNRESAMPLER_WIDE_ACCUMULATOR'. */
+/*#define CLOWNRESAMPLER_16_BIT_KERNEL*/
+
+/* Declares 'ClownResampler_builtin_precomputed', a kernel that was precomputed
+   at build time. The definition must be generated by 'tools/generate-table.c',
+   which the CMake build script can do automatically. */
+/*#define CLOWNRESAMPLER_USE_BUILTIN_TABLE*/
+
+/* Makes the high-level API store its input in a ring buffer, so that refilling
+   it never moves the frames that are already in it. Normally, the frames at
+   the end of the buffer are moved to the start of it on every refill, which
+   can take a while when the kernel is wide. The ring buffer is mirrored so
+   that the resampler can still read it contiguously: this costs an extra copy
+   of each new frame, and halves the number of frames that the buffer holds. */
+/*#define CLOWNRESAMPLER_RING_BUFFER*/
+
+/* Disables the half-band fast path. Normally, when the input sample rate is
+   exactly double the output sample rate, or when the kernel is not stretched
+   at all (such as when upsampling), the output frames that line up exactly
+   with an input frame skip the taps that land on the kernel's zero-crossings.
+   This is only a shortcut for exactly 2:1: it is not a cascade of 2:1 stages,
+   so ratios such as 4:1 and 8:1 do not use it (see
+   'CLOWNRESAMPLER_DECIMATION_STAGES' for that).
+   This also disables copying the input straight to the output when the input
+   and output sample rates match and the low-pass filter is at or above them.
+   This does not change the output, so this is only useful for testing. */
+/*#define CLOWNRESAMPLER_NO_HALF_BAND*/
+
+/* Disables the SSE2, SSE4.1, and AVX2 convolution routines, which are
+   otherwise selected at runtime on x86 CPUs that support them. */
+/*#define CLOWNRESAMPLER_NO_SIMD*/
+
+/* Disables only the AVX2 convolution routines. */
+/*#define CLOWNRESAMPLER_NO_AVX2*/
+
 /* Disables the low-level API. */
 /*#define CLOWNRESAMPLER_NO_LOW_LEVEL_API*/
 
@@ -471,6 +557,20 @@ int main(int argc, char **argv)
 /* Disables the ClownResampler_HighLevel_ResampleEnd function. */
 /*#define CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END*/
 
+/* Removes the input buffer that is built into the high-level resampler states,
+   along with the 'ClownResampler_HighLevel_Init' and
+   'ClownResampler_HighLevelFloat_Init' functions that use it. This makes the
+   states 8KB and 16KB smaller, which is worthwhile when every resampler is
+   given a buffer with the 'InitWithBuffer' functions instead. */
+/*#define CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER*/
+
+/* Disables the band-limited step API. */
+/*#define CLOWNRESAMPLER_NO_STEP_API*/
+
+/* Disables the floating-point API. This API is built on the low-level API, so
+   it must be disabled along with it. */
+/*#define CLOWNRESAMPLER_NO_FLOAT_API*/
+
 
 /* 3. Header & Documentation */
 
@@ -624,42 +724,216 @@ enum
 #define CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(x) (((x) + (CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE - 1)) / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE)
 #define CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(a, b) ((a) * (b) / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE)
 
+/* The gain at which the mixing functions leave the volume unchanged (1.0 in 16.16 fixed point). It is also the highest gain allowed. */
+#define CLOWNRESAMPLER_GAIN_UNITY CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE
+
+/* The widest that the stretched kernel's radius can be, in frames. Each tap adds no more than 0x8000 (a sample multiplied
+   by 1.0) to the accumulators, so this keeps the sum of every tap within 32 bits. */
+#define CLOWNRESAMPLER_MAXIMUM_STRETCHED_KERNEL_RADIUS 0x7FFF
+
+/* The number of entries in the kernel table of a 'ClownResampler_Precomputed'. */
+#if defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL)
+ #define CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution) ((kernel_radius) * (kernel_resolution) + 1) /* From the centre of the kernel to its edge. */
+#elif defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+ #define CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution) ((kernel_radius) * 2 * (kernel_resolution) + 1) /* The extra entry is the right edge of the kernel, to interpolate towards. */
+#elif defined(CLOWNRESAMPLER_FIXED_TAPS)
+ #define CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution) (((kernel_radius) * 2 + 2) * (kernel_resolution)) /* The kernel is padded with silence at both ends. */
+#else
+ #define CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution) ((kernel_radius) * 2 * (kernel_resolution))
+#endif
+
+/* The number of entries in the kernel table of a 'ClownResampler_PrecomputedFloat'. This is always the whole kernel,
+   with an extra entry for its right edge, regardless of the layout of the integer table. */
+#define CLOWNRESAMPLER_FLOAT_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution) ((kernel_radius) * 2 * (kernel_resolution) + 1)
+
+/* The type of the entries in the kernel table of a 'ClownResampler_Precomputed'. */
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+typedef cc_s16l ClownResampler_KernelValue; /* Q1.15 fixed point. */
+#else
+typedef cc_s32l ClownResampler_KernelValue; /* 16.16 fixed point. */
+#endif
+
 typedef struct ClownResampler_Precomputed
 {
-	cc_s32l lanczos_kernel_table[CLOWNRESAMPLER_KERNEL_RADIUS * 2 * CLOWNRESAMPLER_KERNEL_RESOLUTION];
+	cc_u32f kernel_radius;
+	cc_u32f kernel_resolution;
+	const ClownResampler_KernelValue *lanczos_kernel_table;
 } ClownResampler_Precomputed;
 
+typedef struct ClownResampler_PrecomputedFloat
+{
+	cc_u32f kernel_radius;
+	cc_u32f kernel_resolution;
+	const float *lanczos_kernel_table;
+} ClownResampler_PrecomputedFloat;
+
 typedef struct ClownResampler_LowestLevel_Configuration
 {
-	cc_s32f sample_normaliser;              /* 17.15 fixed point. */
+	cc_u32f kernel_radius;
+	cc_u32f kernel_resolution;
+
+	cc_s32f sample_normaliser;              /* 17.15 fixed point, applied after the accumulators are divided by 1 << 'normaliser_shift'. */
+	cc_u8f normaliser_shift;                /* 0 unless the kernel is so wide that the normaliser needs more precision. */
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+	float float_sample_normaliser;          /* The same as 'sample_normaliser', for the floating-point API. */
+#endif
 	size_t stretched_kernel_radius;         /* 16.16 fixed point. */
 	size_t integer_stretched_kernel_radius;
 	size_t stretched_kernel_radius_delta;   /* 16.16 fixed point. */
-	size_t kernel_step_size;
+	size_t kernel_step_size;                /* 16.16 fixed point if 'CLOWNRESAMPLER_INTERPOLATE_KERNEL' is defined. */
+	cc_u8f half_band_factor;                /* 1 or 2 if the kernel is stretched by exactly that much, otherwise 0. */
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	struct
+	{
+		cc_u32f total_phases;           /* 0 if the filter-bank is not being used. */
+		size_t increment_integer;
+		cc_u32f increment_phase;
+		const ClownResampler_KernelValue *bank; /* The same format as the kernel table. Owned by the caller. */
+	} polyphase;
+#endif
 } ClownResampler_LowestLevel_Configuration;
 
+/* The type that the convolution sums the products of the samples and the
+   kernel in. Normally, each product is rounded down to 16 bits before being
+   added, but 'CLOWNRESAMPLER_WIDE_ACCUMULATOR' keeps the full 16.16 products. */
+#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+ #ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+  #error "'CLOWNRESAMPLER_WIDE_ACCUMULATOR' and 'CLOWNRESAMPLER_16_BIT_KERNEL' cannot be used together."
+ #endif
+ #if defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR_TYPE)
+typedef CLOWNRESAMPLER_WIDE_ACCUMULATOR_TYPE ClownResampler_Accumulator;
+ #elif (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L) || (defined(__cplusplus) && __cplusplus >= 201103L)
+typedef long long ClownResampler_Accumulator;
+ #elif defined(_MSC_VER)
+typedef __int64 ClownResampler_Accumulator;
+ #elif defined(__GNUC__)
+/* 'long long' is an extension in C89, so this stops '-pedantic' from warning about it. */
+__extension__ typedef long long ClownResampler_Accumulator;
+ #else
+  #error "'CLOWNRESAMPLER_WIDE_ACCUMULATOR' needs a 64-bit integer type: define 'CLOWNRESAMPLER_WIDE_ACCUMULATOR_TYPE' as one."
+ #endif
+#else
+typedef cc_s32f ClownResampler_Accumulator;
+#endif
+
+/* Convolves a run of frames with the kernel, and writes the result to
+   'output_frame', overwriting what was there rather than adding to it, so
+   the caller does not need to clear it first. 'kernel_step_size' may be
+   negative, to walk the kernel backwards. The low-level API uses this to
+   select an implementation that suits the CPU and the number of channels. */
+typedef void (*ClownResampler_ConvolveFunction)(ClownResampler_Accumulator *output_frame, cc_u8f channels, const cc_s16l *input_buffer, size_t total_frames, const ClownResampler_KernelValue *kernel, ptrdiff_t kernel_step_size);
+
+/* Like 'ClownResampler_ConvolveFunction', but produces 'total_kernels' output frames from the same input frames, each
+   with its own kernel, so that every input frame is only read once. The output frames are stored one after the other.
+   When upsampling, several output frames lie between each pair of input frames, so they can share their input frames. */
+typedef void (*ClownResampler_ConvolveWindowFunction)(ClownResampler_Accumulator *output_frames, cc_u8f channels, const cc_s16l *input_buffer, size_t total_frames, const ClownResampler_KernelValue* const *kernels, cc_u8f total_kernels, ptrdiff_t kernel_step_size);
+
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+/* The floating-point API's equivalent of 'ClownResampler_ConvolveFunction'. Rather than being walked with a step size,
+   the kernel values are gathered into a contiguous array beforehand, and the products are added to 'output_frame'. */
+typedef void (*ClownResampler_AccumulateFloatFunction)(float *output_frame, cc_u8f channels, const float *input_buffer, size_t total_frames, const float *kernel);
+#endif
+
 typedef struct ClownResampler_LowLevel_State
 {
 	ClownResampler_LowestLevel_Configuration lowest_level;
+	ClownResampler_ConvolveFunction convolve;
+	ClownResampler_ConvolveWindowFunction convolve_window; /* NULL if there is no routine that suits the CPU. */
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+	ClownResampler_AccumulateFloatFunction accumulate_float; /* Only set by 'ClownResampler_LowLevel_InitFloat'. */
+#endif
 
 	cc_u8f channels;
 	size_t position_integer;
-	cc_u32f position_fractional;            /* 16.16 fixed point. */
+	cc_u32f position_fractional;            /* 16.16 fixed point. Not used while the polyphase filter-bank is. */
 	cc_u32f increment;                      /* 16.16 fixed point. */
+	cc_bool passthrough;                    /* Whether the input and output sample rates match, with nothing to filter. */
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	cc_u32f position_phase;                 /* Used instead of 'position_fractional' while the filter-bank is. */
+	ClownResampler_KernelValue *polyphase_bank; /* NULL if the resampler has not been given one. */
+	size_t polyphase_bank_length;           /* In coefficients. */
+	cc_u32f input_sample_rate;              /* The rates that were last passed to 'ClownResampler_LowLevel_Adjust', */
+	cc_u32f output_sample_rate;             /* so that the filter-bank can be made when it is given. */
+	cc_u32f low_pass_filter_sample_rate;
+#endif
 } ClownResampler_LowLevel_State;
 
+/* The number of input frames on either side of the centre of a decimation stage's half-band filter, and the number
+   of frames that a stage keeps from one call to the next, which is every frame that the filter spans except for one. */
+#define CLOWNRESAMPLER_DECIMATION_STAGE_RADIUS 7
+#define CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY (CLOWNRESAMPLER_DECIMATION_STAGE_RADIUS * 2)
+
 typedef struct ClownResampler_HighLevel_State
 {
 	ClownResampler_LowLevel_State low_level;
 
-	cc_s16l input_buffer[0x1000]; /* TODO: This should be dynamically allocated in accordance with the kernel radius... */
-	cc_s16l *input_buffer_start;
-	cc_s16l *input_buffer_end;
+	cc_s16l *input_buffer;          /* NULL when 'default_input_buffer' is used, so that the state can be copied. */
+	size_t input_buffer_size;       /* In samples. */
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+	cc_s16l default_input_buffer[0x1000]; /* Used by 'ClownResampler_HighLevel_Init'. */
+#endif
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	size_t ring_buffer_size;        /* In samples. The rest of 'input_buffer' mirrors this many samples at its start. */
+	size_t ring_buffer_read_index;  /* The sample of the frame that is currently being resampled. */
+	size_t ring_buffer_write_index; /* The sample that the next input frame will be written to. */
+#else
+	size_t input_buffer_start;      /* In samples. The first sample that is left to be resampled. */
+	size_t input_buffer_end;        /* In samples. The sample after the last one that is left to be resampled. */
+#endif
 	size_t maximum_integer_stretched_kernel_radius;
 	size_t leading_padding_frames_needed, trailing_padding_frames_remaining;
+
+	cc_u32f decimation_factor; /* The number of input frames per frame that is passed to the low-level API. */
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+	struct
+	{
+		cc_u32f integrators[3 * CLOWNRESAMPLER_MAXIMUM_CHANNELS];  /* These deliberately wrap around. */
+		cc_u32f comb_delays[3 * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+		cc_s16l compensation_history[2 * CLOWNRESAMPLER_MAXIMUM_CHANNELS]; /* The last two frames that came out of the combs. */
+		cc_u32f frames_until_output;
+		cc_u32f gain; /* The cube of 'decimation_factor'. */
+		cc_s32f compensation; /* 20.12 fixed point. */
+	} cic;
+#elif defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+	cc_u8f total_decimation_stages;
+	struct
+	{
+		cc_s16l history[CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY * CLOWNRESAMPLER_MAXIMUM_CHANNELS]; /* The last frames that were input to this stage. */
+		cc_u8f next_centre; /* The frame that the next output frame is centred on, counting from the start of 'history'. */
+	} decimation_stages[CLOWNRESAMPLER_MAXIMUM_DECIMATION_STAGES];
+#endif
 } ClownResampler_HighLevel_State;
 
+typedef struct ClownResampler_Step_State
+{
+	cc_u8f channels;
+	cc_u32f frames_per_clock;               /* 0.32 fixed point. */
+	size_t integer_stretched_kernel_radius; /* In output frames. */
+	size_t total_taps;                      /* The number of frames that each step affects. */
+	size_t position_integer;                /* The output frame that the current clock frame begins in. */
+	cc_u32f position_fractional;            /* 0.32 fixed point. */
+	cc_s32f *buffer;                        /* The deltas of the frames that have not been read yet. */
+	size_t buffer_frames;
+	cc_s32f levels[CLOWNRESAMPLER_MAXIMUM_CHANNELS]; /* The sum of every delta that has been read so far. */
+	cc_s32l bank[CLOWNRESAMPLER_STEP_MAXIMUM_COEFFICIENTS]; /* 17.15 fixed point. The coefficients of each phase sum to 1. */
+} ClownResampler_Step_State;
+
+typedef struct ClownResampler_HighLevelFloat_State
+{
+	ClownResampler_LowLevel_State low_level;
+
+	float *input_buffer;            /* The same as in 'ClownResampler_HighLevel_State'. */
+	size_t input_buffer_size;       /* In samples. */
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+	float default_input_buffer[0x1000]; /* Used by 'ClownResampler_HighLevelFloat_Init'. */
+#endif
+	size_t input_buffer_start;      /* In samples. The same as in 'ClownResampler_HighLevel_State'. */
+	size_t input_buffer_end;        /* In samples. */
+	size_t leading_padding_frames_needed, trailing_padding_frames_remaining;
+} ClownResampler_HighLevelFloat_State;
+
 typedef size_t (*ClownResampler_InputCallback)(void *user_data, cc_s16l *buffer, size_t total_frames);
+typedef size_t (*ClownResampler_InputCallbackFloat)(void *user_data, float *buffer, size_t total_frames);
 typedef cc_bool (*ClownResampler_OutputCallback)(void *user_data, const cc_s32f *frame, cc_u8f total_samples);
 
 #endif /* CLOWNRESAMPLER_GUARD_MISC */
@@ -677,16 +951,55 @@ extern "C" {
 
 /* Precomputes some data to improve the performance of the resampler.
    Multiple resamplers can use the same 'ClownResampler_Precomputed'.
+
+   'kernel_radius' is the number of 'lobes' of the windowed sinc function: a
+   higher number results in better audio, but is more expensive.
+   'kernel_resolution' is the number of samples to render per lobe: a higher
+   number produces a higher-quality kernel, but takes up more memory and cache.
+   'CLOWNRESAMPLER_KERNEL_RADIUS' and 'CLOWNRESAMPLER_KERNEL_RESOLUTION' are
+   sensible defaults for these.
+
+   'kernel_table' is where the kernel is rendered to, and must be
+   'CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution)'
+   entries long. It must remain valid for as long as 'precomputed' is in use.
+
    The output of this function is always the same, so if you want to avoid
-   calling this function, then you could dump the contents of the struct and
-   then insert a const 'ClownResampler_Precomputed' in your source code. */
-CLOWNRESAMPLER_API void ClownResampler_Precompute(ClownResampler_Precomputed *precomputed);
+   calling this function, then you could dump the contents of the kernel table
+   and then insert a const 'ClownResampler_Precomputed' in your source code. */
+CLOWNRESAMPLER_API void ClownResampler_Precompute(ClownResampler_Precomputed *precomputed, ClownResampler_KernelValue *kernel_table, cc_u32f kernel_radius, cc_u32f kernel_resolution);
+
+#ifdef CLOWNRESAMPLER_USE_BUILTIN_TABLE
+/* A kernel that was precomputed at build time by 'tools/generate-table.c', which
+   can be used instead of calling 'ClownResampler_Precompute'. The CMake build
+   script generates this when 'CLOWNRESAMPLER_USE_BUILTIN_TABLE' is enabled,
+   using the radius and resolution in 'CLOWNRESAMPLER_BUILTIN_KERNEL_RADIUS' and
+   'CLOWNRESAMPLER_BUILTIN_KERNEL_RESOLUTION'. */
+extern const ClownResampler_Precomputed ClownResampler_builtin_precomputed;
+#endif
 
 
 
 /* Lowest-level API. */
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_Configure(ClownResampler_LowestLevel_Configuration *configuration, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+/* 'kernel_radius' and 'kernel_resolution' must match those of the
+   'ClownResampler_Precomputed' that the configuration will be used with.
+   Fails if the kernel would be stretched so far that its radius is more than
+   'CLOWNRESAMPLER_MAXIMUM_STRETCHED_KERNEL_RADIUS' frames. */
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_Configure(ClownResampler_LowestLevel_Configuration *configuration, cc_u32f kernel_radius, cc_u32f kernel_resolution, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
 CLOWNRESAMPLER_API void ClownResampler_LowestLevel_Resample(const ClownResampler_LowestLevel_Configuration *configuration, const ClownResampler_Precomputed *precomputed, cc_s32f *output_frame, cc_u8f channels, const cc_s16l *input_buffer, size_t position_integer, cc_u32f position_fractional);
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* Like 'ClownResampler_LowestLevel_Resample', but uses the configuration's
+   polyphase filter-bank. This must only be used when
+   'configuration->polyphase.total_phases' is not 0, and 'phase' must be lower
+   than it. */
+CLOWNRESAMPLER_API void ClownResampler_LowestLevel_ResamplePolyphase(const ClownResampler_LowestLevel_Configuration *configuration, cc_s32f *output_frame, cc_u8f channels, const cc_s16l *input_buffer, size_t position_integer, cc_u32f phase);
+/* Makes a polyphase filter-bank for the configuration in 'bank', which is
+   'bank_length' coefficients long, and must remain valid for as long as the
+   configuration is in use. 'ClownResampler_LowestLevel_Configure' must be
+   called first, with the same sample rates. Returns 'cc_false', leaving
+   'configuration->polyphase.total_phases' at 0, if the ratio is too complex
+   for the filter-bank to fit in 'bank', or needs more than 0xFFFF phases. */
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_ConfigurePolyphase(ClownResampler_LowestLevel_Configuration *configuration, ClownResampler_KernelValue *bank, size_t bank_length, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+#endif
 
 #endif /* CLOWNRESAMPLER_GUARD_FUNCTION_DECLARATIONS */
 
@@ -708,8 +1021,12 @@ CLOWNRESAMPLER_API void ClownResampler_LowestLevel_Resample(const ClownResampler
    The 'channels' parameter must not be larger than
    CLOWNRESAMPLER_MAXIMUM_CHANNELS.
 
+   The resampler uses the kernel radius and resolution of 'precomputed', and
+   must only ever be given a 'ClownResampler_Precomputed' with the same radius
+   and resolution.
+
    Returns 'cc_false' on failure, and 'cc_true' otherwise. */
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Init(ClownResampler_LowLevel_State *resampler, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Init(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
 
 /* Adjusts properties of the resampler. The input and output sample rates do
    not actually have to match the sample rates being used - they just need to
@@ -719,6 +1036,17 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Init(ClownResampler_LowLevel_
    Returns 'cc_false' on failure, and 'cc_true' otherwise. */
 CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Adjust(ClownResampler_LowLevel_State *resampler, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
 
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* Gives the resampler a buffer to store a polyphase filter-bank in, which is
+   'bank_length' coefficients long. The filter-bank is made straight away, and
+   is remade by 'ClownResampler_LowLevel_Adjust'. If the ratio is too complex
+   for the filter-bank to fit, then the regular kernel is used instead. The
+   buffer must remain valid for as long as the resampler is in use, or until
+   this is called again. Passing NULL stops the filter-bank from being used.
+   'CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS' is a suitable length. */
+CLOWNRESAMPLER_API void ClownResampler_LowLevel_SetPolyphaseBank(ClownResampler_LowLevel_State *resampler, ClownResampler_KernelValue *bank, size_t bank_length);
+#endif
+
 /* Resamples (pre-processed) audio. The 'total_input_frames' and
    'total_output_frames' parameters measure the size of their respective
    buffers in frames, not samples nor bytes.
@@ -748,6 +1076,101 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Adjust(ClownResampler_LowLeve
    input samples, or 'cc_false' if it terminated because the callback returned
    0. */
 CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Resample(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t *total_input_frames, ClownResampler_OutputCallback output_callback, const void *user_data);
+
+/* Like 'ClownResampler_LowLevel_Resample', but writes the frames to
+   'output_buffer' instead of passing them to a callback, avoiding the overhead
+   of calling a function for every frame. 'total_output_frames' is the size of
+   the output buffer in frames, not samples nor bytes.
+
+   'ClownResampler_LowLevel_ResampleToS32' outputs the frames exactly as the
+   callback would receive them, while 'ClownResampler_LowLevel_ResampleToS16'
+   clamps them to 16-bit.
+
+   As with 'ClownResampler_LowLevel_Resample', the 'total_input_frames'
+   parameter will contain the number of frames in the input buffer that were
+   not processed after this function returns.
+
+   Returns the number of frames that were written to the output buffer. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToS32(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t *total_input_frames, cc_s32f *output_buffer, size_t total_output_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToS16(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t *total_input_frames, cc_s16l *output_buffer, size_t total_output_frames);
+
+/* Like 'ClownResampler_LowLevel_ResampleToS32', but adds the frames to
+   'output_buffer' instead of overwriting it, so that many resamplers can be
+   mixed together into one buffer without an intermediate buffer for each.
+
+   'gain' is the volume of the resampled audio, in 16.16 fixed point. It must
+   not be greater than 'CLOWNRESAMPLER_GAIN_UNITY', which leaves the volume
+   unchanged, so that the frames cannot overflow. The gain is applied along
+   with the resampler's own normalisation, so it does not cost anything extra
+   per sample, but this means that it is multiplied into the 17.15 fixed-point
+   normaliser and is truncated to the normaliser's precision: at least the
+   lowest bit of the gain is lost, and more of them are when downsampling.
+   This is the same regardless of how the frames are produced.
+
+   Returns the number of frames that were added to the output buffer. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_MixToS32(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t *total_input_frames, cc_s32f *output_buffer, size_t total_output_frames, cc_u32f gain);
+
+/* Moves the resampler to the position that it would be at after producing
+   'output_frame' frames from the start of the input buffer, as if it had
+   just been initialised. This lets the resampler start anywhere in the audio
+   without resampling everything before it first. The input buffer must then
+   be passed to the resampling functions from its start. */
+CLOWNRESAMPLER_API void ClownResampler_LowLevel_Seek(ClownResampler_LowLevel_State *resampler, size_t output_frame);
+
+/* Returns the number of frames that resampling the whole of an input buffer
+   that is 'total_input_frames' frames long (not counting its padding) will
+   produce, starting from the beginning. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_GetTotalOutputFrames(const ClownResampler_LowLevel_State *resampler, size_t total_input_frames);
+
+/* Resamples one chunk of the output, starting at frame 'first_output_frame'
+   and being up to 'total_output_frames' frames long. 'input_buffer' and
+   'total_input_frames' are the whole of the (padded) input, not just the
+   part that the chunk covers.
+
+   'resampler' is not modified, so many threads can use the same resampler to
+   produce different chunks of the output at once. Splitting the output into
+   chunks and resampling them in any order produces exactly the same frames as
+   resampling it all in one go with 'ClownResampler_LowLevel_ResampleToS32'
+   or 'ClownResampler_LowLevel_ResampleToS16'. Use
+   'ClownResampler_LowLevel_GetTotalOutputFrames' to find how large the output
+   is.
+
+   Returns the number of frames that were written to the output buffer. This
+   is only less than 'total_output_frames' if the chunk reaches the end of
+   the output. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleChunkToS32(const ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t total_input_frames, size_t first_output_frame, cc_s32f *output_buffer, size_t total_output_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleChunkToS16(const ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t total_input_frames, size_t first_output_frame, cc_s16l *output_buffer, size_t total_output_frames);
+
+/* Splits the output of resampling an input buffer that is
+   'total_input_frames' frames long (not counting its padding) into
+   'total_chunks' chunks of nearly the same size, such as one for each thread.
+   The first frame of the chunk numbered 'chunk_index' is written to
+   'first_output_frame', and the number of frames in it is returned. These can
+   be passed straight to 'ClownResampler_LowLevel_ResampleChunkToS32' or
+   'ClownResampler_LowLevel_ResampleChunkToS16'. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_GetChunk(const ClownResampler_LowLevel_State *resampler, size_t total_input_frames, size_t total_chunks, size_t chunk_index, size_t *first_output_frame);
+
+/* Like 'ClownResampler_LowLevel_Resample', 'ClownResampler_LowLevel_ResampleToS32',
+   and 'ClownResampler_LowLevel_ResampleToS16', except that the input buffer
+   does not need to be padded: the frames before the start and after the end
+   of the buffer are treated as silence. This allows audio to be resampled
+   straight from wherever it was decoded to, without having to be copied into
+   a padded buffer first.
+
+   Because the edges of the buffer are treated as the edges of the audio,
+   'input_buffer' must contain the entirety of the audio, and the same buffer
+   must be passed to every call. Rather than the caller stepping through the
+   buffer, the resampler remembers its position within it, so
+   'total_input_frames' is not modified. Do not mix these functions with the
+   padded ones for the same resampler.
+
+   'ClownResampler_LowLevel_ResampleUnpadded' returns 'cc_true' if it
+   terminated because it ran out of input samples, or 'cc_false' if it
+   terminated because the callback returned 0. The other two functions return
+   the number of frames that were written to the output buffer. */
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_ResampleUnpadded(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t total_input_frames, ClownResampler_OutputCallback output_callback, const void *user_data);
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToS32(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t total_input_frames, cc_s32f *output_buffer, size_t total_output_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToS16(ClownResampler_LowLevel_State *resampler, const ClownResampler_Precomputed *precomputed, const cc_s16l *input_buffer, size_t total_input_frames, cc_s16l *output_buffer, size_t total_output_frames);
 #endif /* CLOWNRESAMPLER_NO_LOW_LEVEL_API */
 
 
@@ -767,8 +1190,59 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Resample(ClownResampler_LowLe
    The 'channels' parameter must not be larger than
    CLOWNRESAMPLER_MAXIMUM_CHANNELS.
 
+   The resampler uses the kernel radius and resolution of 'precomputed', and
+   must only ever be given a 'ClownResampler_Precomputed' with the same radius
+   and resolution.
+
+   The resampler stores its input frames in a small buffer within
+   'ClownResampler_HighLevel_State'. This is too small for kernels that are
+   very wide, such as those produced by large radii or extreme downsampling,
+   in which case this function will fail. Use
+   'ClownResampler_HighLevel_InitWithBuffer' to provide a larger buffer. The
+   buffer, and this function, are removed when
+   'CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER' is defined.
+
+   If 'CLOWNRESAMPLER_DECIMATION_STAGES' is defined and the input sample rate
+   is more than 'CLOWNRESAMPLER_DECIMATION_THRESHOLD' times the lower of the
+   output and low-pass filter sample rates, then the input is first passed
+   through a series of 2:1 decimation stages, which make large downsampling
+   ratios much cheaper, and allow ratios that are too large for the low-level
+   API. If 'CLOWNRESAMPLER_CIC_DECIMATOR' is defined, then a single CIC filter
+   is used instead.
+
+   Returns 'cc_false' on failure, and 'cc_true' otherwise. */
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Init(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+#endif
+
+/* Like 'ClownResampler_HighLevel_Init', but stores input frames in
+   'input_buffer' instead of the buffer within 'ClownResampler_HighLevel_State'.
+   'input_buffer_size' is measured in samples, not frames nor bytes. The buffer
+   must remain valid for as long as the resampler is in use.
+
+   A larger buffer means that the input callback is called less often, and
+   that more frames are resampled per call to the low-level API. A suitable
+   size can be found with 'ClownResampler_HighLevel_GetInputBufferSize'.
+
    Returns 'cc_false' on failure, and 'cc_true' otherwise. */
-CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Init(ClownResampler_HighLevel_State *resampler, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_InitWithBuffer(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate, cc_s16l *input_buffer, size_t input_buffer_size);
+
+/* Returns the size, in samples, of an input buffer that can hold
+   'total_frames' frames at a time, along with the frames on either side of
+   them that the kernel needs. The parameters are the same as those of
+   'ClownResampler_HighLevel_InitWithBuffer'. If the resampler is to be
+   adjusted later, then pass the rates that produce the widest kernel (the
+   lowest of the output and low-pass filter sample rates relative to the input
+   sample rate).
+
+   Returns 0 if the rates are invalid, or if the size would not fit in a
+   'size_t'. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_GetInputBufferSize(const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate, size_t total_frames);
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* The same as 'ClownResampler_LowLevel_SetPolyphaseBank'. */
+CLOWNRESAMPLER_API void ClownResampler_HighLevel_SetPolyphaseBank(ClownResampler_HighLevel_State *resampler, ClownResampler_KernelValue *bank, size_t bank_length);
+#endif
 
 /* Resamples audio. This function returns when either the output buffer is
    full, or the input callback stops providing frames.
@@ -824,6 +1298,38 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Init(ClownResampler_HighLeve
    'user_data'
    An arbitrary pointer that is passed to the callback functions. */
 CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Resample(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, ClownResampler_InputCallback input_callback, ClownResampler_OutputCallback output_callback, const void *user_data);
+
+/* Like 'ClownResampler_HighLevel_Resample', but writes the frames to
+   'output_buffer' instead of passing them to a callback, avoiding the overhead
+   of calling a function for every frame. 'total_output_frames' is the size of
+   the output buffer in frames, not samples nor bytes.
+
+   'ClownResampler_HighLevel_ResampleToS32' outputs the frames exactly as the
+   callback would receive them, while 'ClownResampler_HighLevel_ResampleToS16'
+   clamps them to 16-bit.
+
+   Returns the number of frames that were written to the output buffer. If
+   this is less than 'total_output_frames', then the input callback returned
+   0. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleToS32(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, ClownResampler_InputCallback input_callback, cc_s32f *output_buffer, size_t total_output_frames, const void *user_data);
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleToS16(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, ClownResampler_InputCallback input_callback, cc_s16l *output_buffer, size_t total_output_frames, const void *user_data);
+
+/* Like 'ClownResampler_HighLevel_ResampleToS32', but adds the frames to
+   'output_buffer' instead of overwriting it, so that many resamplers can be
+   mixed together into one buffer without an intermediate buffer for each.
+
+   'gain' is the volume of the resampled audio, in 16.16 fixed point. It must
+   not be greater than 'CLOWNRESAMPLER_GAIN_UNITY', which leaves the volume
+   unchanged, so that the frames cannot overflow. The gain is applied along
+   with the resampler's own normalisation, so it does not cost anything extra
+   per sample, but this means that it is multiplied into the 17.15 fixed-point
+   normaliser and is truncated to the normaliser's precision: at least the
+   lowest bit of the gain is lost, and more of them are when downsampling.
+   This is the same regardless of how the frames are produced.
+
+   Returns the number of frames that were added to the output buffer. If this
+   is less than 'total_output_frames', then the input callback returned 0. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_MixToS32(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, ClownResampler_InputCallback input_callback, cc_s32f *output_buffer, size_t total_output_frames, cc_u32f gain, const void *user_data);
 #endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_API */
 
 #if !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST) && !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_API)
@@ -835,6 +1341,10 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Resample(ClownResampler_High
    Unlike in the low-level API, when the input sample rate is higher than the
    output sample rate, the ratio between the two MUST NOT be wider than that
    of the rates passed to the 'ClownResampler_HighLevel_Init' function.
+   Likewise, the number of decimation stages (or the decimation factor of the
+   CIC filter) is decided by 'ClownResampler_HighLevel_Init' and is not changed
+   by this function, although the filter that corrects the CIC filter's droop
+   is remade to suit the new low-pass filter sample rate.
 
    Returns 'cc_false' on failure, and 'cc_true' otherwise. */
 CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Adjust(ClownResampler_HighLevel_State *resampler, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
@@ -846,8 +1356,146 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Adjust(ClownResampler_HighLe
 
   Returns 'cc_true' when the final sample has been output. */
 CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_ResampleEnd(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, ClownResampler_OutputCallback output_callback, const void *user_data);
+
+/* Versions of 'ClownResampler_HighLevel_ResampleEnd' to go with
+  'ClownResampler_HighLevel_ResampleToS32' and
+  'ClownResampler_HighLevel_ResampleToS16'.
+
+  Returns the number of frames that were written to the output buffer. If this
+  is less than 'total_output_frames', then the final sample has been output. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleEndToS32(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_s32f *output_buffer, size_t total_output_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleEndToS16(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_s16l *output_buffer, size_t total_output_frames);
+
+/* A version of 'ClownResampler_HighLevel_ResampleEnd' to go with
+  'ClownResampler_HighLevel_MixToS32'.
+
+  Returns the number of frames that were added to the output buffer. If this
+  is less than 'total_output_frames', then the final sample has been output. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_MixEndToS32(ClownResampler_HighLevel_State *resampler, const ClownResampler_Precomputed *precomputed, cc_s32f *output_buffer, size_t total_output_frames, cc_u32f gain);
 #endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END */
 
+
+
+#ifndef CLOWNRESAMPLER_NO_STEP_API
+/* Band-limited step API.
+   This API is for sources that only ever change their output at sparse points
+   in time, such as the square waves of a PSG. Instead of every sample being
+   passed through a resampler, each change is given as a timestamp and an
+   amplitude delta, and a band-limited step made from the Lanczos kernel is
+   added to the output for it. This makes the cost scale with the number of
+   changes rather than with the source's sample rate. */
+
+
+/* Initialises a band-limited step synthesiser. This function must be called
+   before the state is passed to any other functions. 'clock_rate' is the rate
+   of the timestamps that are given to 'ClownResampler_Step_AddDelta', and
+   must be higher than 'output_sample_rate'. As with the resamplers, these
+   rates only need to provide the ratio between the two.
+
+   Each step is made by integrating the kernel table of 'precomputed', which
+   is done once for every phase by this function.
+
+   Deltas are accumulated in 'buffer', which is 'buffer_size' samples long.
+   The buffer must remain valid for as long as the synthesiser is in use. A
+   suitable size can be found with 'ClownResampler_Step_GetBufferSize'.
+
+   So that a step never affects frames that have already been read, the output
+   is delayed by the radius of the stretched kernel, which is
+   'integer_stretched_kernel_radius' frames.
+
+   Returns 'cc_false' on failure, and 'cc_true' otherwise. */
+CLOWNRESAMPLER_API cc_bool ClownResampler_Step_Init(ClownResampler_Step_State *step, const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f clock_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate, cc_s32f *buffer, size_t buffer_size);
+
+/* Returns the size of the buffer, in samples, that is needed to hold
+   'total_frames' frames that have not been read yet. This should be at least
+   the number of frames that are produced between each read, including a whole
+   clock frame's worth.
+
+   Returns 0 on failure. */
+CLOWNRESAMPLER_API size_t ClownResampler_Step_GetBufferSize(const ClownResampler_Precomputed *precomputed, cc_u8f channels, cc_u32f clock_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate, size_t total_frames);
+
+/* Adds a band-limited step to the output of 'channel'. 'clock' is measured
+   from the start of the current clock frame, which is ended by
+   'ClownResampler_Step_EndFrame'. 'delta' is the change in amplitude, and must
+   be between -0xFFFF and 0xFFFF, which is enough to go from one extreme of a
+   16-bit sample to the other. */
+CLOWNRESAMPLER_API void ClownResampler_Step_AddDelta(ClownResampler_Step_State *step, cc_u32f clock, cc_u8f channel, cc_s32f delta);
+
+/* Ends the current clock frame, which is 'total_clocks' clocks long. The next
+   clock frame begins where this one ends, and the output frames before it are
+   made available to read. */
+CLOWNRESAMPLER_API void ClownResampler_Step_EndFrame(ClownResampler_Step_State *step, cc_u32f total_clocks);
+
+/* Returns the number of frames that are available to read. */
+CLOWNRESAMPLER_API size_t ClownResampler_Step_GetAvailableFrames(const ClownResampler_Step_State *step);
+
+/* Reads up to 'total_frames' frames to 'output_buffer'. The S16 function clamps
+   the samples to 16 bits.
+
+   Returns the number of frames that were read. */
+CLOWNRESAMPLER_API size_t ClownResampler_Step_ReadToS32(ClownResampler_Step_State *step, cc_s32f *output_buffer, size_t total_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_Step_ReadToS16(ClownResampler_Step_State *step, cc_s16l *output_buffer, size_t total_frames);
+#endif /* CLOWNRESAMPLER_NO_STEP_API */
+
+
+
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+/* Floating-point API.
+   These are versions of the other APIs that take and produce 'float' frames
+   instead of 16-bit and 32-bit integer ones, for programs that process their
+   audio as floating-point. The samples can be of any scale, and come out at
+   the same scale that they went in at: there is no clamping, and no
+   conversion to or from fixed point. The frames are interleaved in the same
+   way as they are for the other APIs. The buffers need no more than the
+   alignment of 'float'.
+
+   These use their own kernel table, but otherwise share the configurations
+   and state of the other APIs. */
+
+
+/* Like 'ClownResampler_Precompute', but renders the kernel as 'float'.
+   'kernel_table' must be 'CLOWNRESAMPLER_FLOAT_KERNEL_TABLE_LENGTH(kernel_radius, kernel_resolution)'
+   entries long. */
+CLOWNRESAMPLER_API void ClownResampler_PrecomputeFloat(ClownResampler_PrecomputedFloat *precomputed, float *kernel_table, cc_u32f kernel_radius, cc_u32f kernel_resolution);
+
+/* Like 'ClownResampler_LowestLevel_Resample'. This always uses the kernel
+   table, even if the configuration has a polyphase filter-bank. */
+CLOWNRESAMPLER_API void ClownResampler_LowestLevel_ResampleFloat(const ClownResampler_LowestLevel_Configuration *configuration, const ClownResampler_PrecomputedFloat *precomputed, float *output_frame, cc_u8f channels, const float *input_buffer, size_t position_integer, cc_u32f position_fractional);
+
+/* Like 'ClownResampler_LowLevel_Init'. A low-level resampler must be
+   initialised with this function to be used with the functions below.
+   'ClownResampler_LowLevel_Adjust', 'ClownResampler_LowLevel_Seek', and
+   'ClownResampler_LowLevel_GetTotalOutputFrames' can be used with it too. */
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_InitFloat(ClownResampler_LowLevel_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+
+/* Like 'ClownResampler_LowLevel_ResampleToS32' and
+   'ClownResampler_LowLevel_ResampleUnpaddedToS32'. */
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToFloat(ClownResampler_LowLevel_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, const float *input_buffer, size_t *total_input_frames, float *output_buffer, size_t total_output_frames);
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToFloat(ClownResampler_LowLevel_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, const float *input_buffer, size_t total_input_frames, float *output_buffer, size_t total_output_frames);
+
+/* Like 'ClownResampler_HighLevel_Init' and 'ClownResampler_HighLevel_InitWithBuffer'.
+   This never uses decimation stages, even when
+   'CLOWNRESAMPLER_DECIMATION_STAGES' is defined, so the stretched kernel's
+   radius can be no more than 'CLOWNRESAMPLER_MAXIMUM_STRETCHED_KERNEL_RADIUS'
+   frames, and the input buffer must be large enough for the whole width of
+   the stretched kernel. The input buffer is never used as a ring buffer. A
+   buffer that can hold 'total_frames' frames on top of
+   the kernel needs '(total_frames + integer_stretched_kernel_radius * 2) * channels'
+   samples, where 'integer_stretched_kernel_radius' is that of the resampler's
+   'low_level.lowest_level'.
+
+   Returns 'cc_false' on failure, and 'cc_true' otherwise. */
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevelFloat_Init(ClownResampler_HighLevelFloat_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate);
+#endif
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevelFloat_InitWithBuffer(ClownResampler_HighLevelFloat_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, cc_u8f channels, cc_u32f input_sample_rate, cc_u32f output_sample_rate, cc_u32f low_pass_filter_sample_rate, float *input_buffer, size_t input_buffer_size);
+
+/* Like 'ClownResampler_HighLevel_ResampleToS32' and
+   'ClownResampler_HighLevel_ResampleEndToS32'. */
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevelFloat_Resample(ClownResampler_HighLevelFloat_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, ClownResampler_InputCallbackFloat input_callback, float *output_buffer, size_t total_output_frames, const void *user_data);
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevelFloat_ResampleEnd(ClownResampler_HighLevelFloat_State *resampler, const ClownResampler_PrecomputedFloat *precomputed, float *output_buffer, size_t total_output_frames);
+#endif /* CLOWNRESAMPLER_NO_FLOAT_API */
+
 #ifdef __cplusplus
 }
 #endif
@@ -888,12 +1536,26 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_ResampleEnd(ClownResampler_H
 #define CLOWNRESAMPLER_MEMMOVE memmove
 #endif
 
+#ifndef CLOWNRESAMPLER_MEMCPY
+#include <string.h>
+#define CLOWNRESAMPLER_MEMCPY memcpy
+#endif
+
 #include <stddef.h>
 
-static double ClownResampler_LanczosKernel(const double x)
-{
-	const double kernel_radius = (double)CLOWNRESAMPLER_KERNEL_RADIUS;
+/* The kernel value that represents 1.0, and the highest kernel value. Q1.15 cannot hold 1.0, so the kernel's peak is clamped. */
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+#define CLOWNRESAMPLER_KERNEL_UNITY 0x8000
+#define CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM 0x7FFF
+#else
+#define CLOWNRESAMPLER_KERNEL_UNITY CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE
+#define CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE
+#endif
+
+#define CLOWNRESAMPLER_TO_KERNEL_VALUE(x) ((ClownResampler_KernelValue)CLOWNRESAMPLER_MIN(CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM, (x) * CLOWNRESAMPLER_KERNEL_UNITY))
 
+static double ClownResampler_LanczosKernel(const double x, const double kernel_radius)
+{
 	const double x_times_pi = x * 3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679; /* 100 digits should be good enough. */
 	const double x_times_pi_divided_by_radius = x_times_pi / kernel_radius;
 
@@ -953,15 +1615,147 @@ static cc_u32f ClownResampler_CalculateRatio(const cc_u32f a, const cc_u32f b)
 	return result;
 }
 
-CLOWNRESAMPLER_API void ClownResampler_Precompute(ClownResampler_Precomputed* const precomputed)
+/* Returns 'a' divided by 'b' in 0.32 fixed point. 'a' must be lower than 'b'. */
+static cc_u32f ClownResampler_CalculateFraction(cc_u32f a, const cc_u32f b)
+{
+	cc_u32f result = 0;
+	cc_u8f i;
+
+	/* Long division, one bit at a time. The remainder is doubled without ever exceeding 'b', so it cannot overflow. */
+	for (i = 0; i < 32; ++i)
+	{
+		result <<= 1;
+
+		if (a >= b - a)
+		{
+			a -= b - a;
+			result |= 1;
+		}
+		else
+		{
+			a += a;
+		}
+	}
+
+	return result & 0xFFFFFFFF;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_Precompute(ClownResampler_Precomputed* const precomputed, ClownResampler_KernelValue* const kernel_table, const cc_u32f kernel_radius, const cc_u32f kernel_resolution)
 {
+#ifndef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+	const size_t total_entries = (size_t)kernel_radius * 2 * kernel_resolution;
+#endif
+#if defined(CLOWNRESAMPLER_FIXED_TAPS) && !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	/* The kernel comes after the padding, so that the taps before the kernel can be reached with negative indices. */
+	ClownResampler_KernelValue* const kernel = &kernel_table[kernel_resolution];
+#else
+	ClownResampler_KernelValue* const kernel = kernel_table;
+#endif
+
 	size_t i;
 
-	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(precomputed->lanczos_kernel_table); ++i)
-		precomputed->lanczos_kernel_table[i] = (cc_s32l)CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(ClownResampler_LanczosKernel(((double)i / (double)CLOWNRESAMPLER_COUNT_OF(precomputed->lanczos_kernel_table) * 2.0 - 1.0) * (double)CLOWNRESAMPLER_KERNEL_RADIUS));
+	precomputed->kernel_radius = kernel_radius;
+	precomputed->kernel_resolution = kernel_resolution;
+	precomputed->lanczos_kernel_table = kernel;
+
+#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+	for (i = 0; i < CLOWNRESAMPLER_KERNEL_TABLE_LENGTH((size_t)kernel_radius, kernel_resolution); ++i)
+		kernel[i] = CLOWNRESAMPLER_TO_KERNEL_VALUE(ClownResampler_LanczosKernel((double)i / (double)kernel_resolution, (double)kernel_radius));
+#else
+	for (i = 0; i < total_entries; ++i)
+		kernel[i] = CLOWNRESAMPLER_TO_KERNEL_VALUE(ClownResampler_LanczosKernel(((double)i / (double)total_entries * 2.0 - 1.0) * (double)kernel_radius, (double)kernel_radius));
+
+ #if defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	kernel[total_entries] = 0;
+ #elif defined(CLOWNRESAMPLER_FIXED_TAPS)
+	for (i = 0; i < kernel_resolution; ++i)
+		kernel_table[i] = kernel[total_entries + i] = 0;
+ #endif
+#endif
+}
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+static cc_u32f ClownResampler_GreatestCommonDivisor(cc_u32f a, cc_u32f b)
+{
+	while (b != 0)
+	{
+		const cc_u32f remainder = a % b;
+
+		a = b;
+		b = remainder;
+	}
+
+	return a;
+}
+
+static double ClownResampler_PolyphaseCoefficient(const double distance, const double kernel_scale, const double kernel_radius)
+{
+	const double x = distance / kernel_scale;
+
+	/* Unlike with the precomputed kernel, taps can land outside of the kernel's radius here. */
+	if (CLOWNRESAMPLER_FABS(x) >= kernel_radius)
+		return 0.0;
+
+	return ClownResampler_LanczosKernel(x, kernel_radius);
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_ConfigurePolyphase(ClownResampler_LowestLevel_Configuration* const configuration, ClownResampler_KernelValue* const bank, const size_t bank_length, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	/* This matches 'ClownResampler_LowestLevel_Configure'. */
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(input_sample_rate, CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate));
+	const cc_u32f divisor = ClownResampler_GreatestCommonDivisor(input_sample_rate, output_sample_rate);
+	const cc_u32f total_phases = divisor == 0 ? 0 : output_sample_rate / divisor;
+	const cc_u32f input_frames_per_cycle = divisor == 0 ? 0 : input_sample_rate / divisor;
+	const size_t total_taps = configuration->integer_stretched_kernel_radius * 2;
+	const double kernel_scale = (double)input_sample_rate / (double)actual_low_pass_sample_rate;
+
+	cc_u32f phase;
+
+	configuration->polyphase.total_phases = 0;
+	configuration->polyphase.bank = NULL;
+
+	/* Fall back on the regular kernel if the ratio is too complex to fit in the filter-bank. The phases are limited to
+	   16 bits so that a phase multiplied by another phase, or by a 16.16 fraction, fits in a 'cc_u32f'. */
+	if (total_phases == 0 || total_phases > 0xFFFF || total_phases > bank_length / total_taps)
+		return cc_false;
+
+	/* Each phase covers the same window of input frames as the regular kernel, with the
+	   frames outside of the kernel's radius being given coefficients of 0. This gives
+	   every phase the same number of taps. */
+	for (phase = 0; phase < total_phases; ++phase)
+	{
+		ClownResampler_KernelValue* const coefficients = &bank[phase * total_taps];
+		const double centre = (double)configuration->integer_stretched_kernel_radius + (double)phase / (double)total_phases;
+
+		double sum;
+		size_t tap;
+
+		/* Rather than use the sample normaliser, normalise the coefficients so that they sum to 1. */
+		sum = 0.0;
+
+		for (tap = 0; tap < total_taps; ++tap)
+			sum += ClownResampler_PolyphaseCoefficient((double)tap - centre, kernel_scale, (double)configuration->kernel_radius);
+
+		for (tap = 0; tap < total_taps; ++tap)
+		{
+			const double coefficient = ClownResampler_PolyphaseCoefficient((double)tap - centre, kernel_scale, (double)configuration->kernel_radius) / sum * (double)CLOWNRESAMPLER_KERNEL_UNITY;
+
+			/* Keep the coefficients within the range of the Lanczos kernel so that multiplying them by a sample
+			   always fits in 32 bits, which the SIMD convolution routines rely on. */
+			coefficients[tap] = (ClownResampler_KernelValue)CLOWNRESAMPLER_CLAMP(1 - CLOWNRESAMPLER_KERNEL_UNITY, CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM, coefficient < 0.0 ? coefficient - 0.5 : coefficient + 0.5);
+		}
+	}
+
+	configuration->polyphase.total_phases = total_phases;
+	configuration->polyphase.increment_integer = input_frames_per_cycle / total_phases;
+	configuration->polyphase.increment_phase = input_frames_per_cycle % total_phases;
+	configuration->polyphase.bank = bank;
+
+	return cc_true;
 }
+#endif
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_Configure(ClownResampler_LowestLevel_Configuration* const configuration, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_Configure(ClownResampler_LowestLevel_Configuration* const configuration, const cc_u32f kernel_radius, const cc_u32f kernel_resolution, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
 {
 	/* Determine the kernel scale. This is used to apply a low-pass filter. Not only is this something that the user may
 	   explicitly request, but it is needed when downsampling to avoid artefacts. */
@@ -970,284 +1764,3370 @@ CLOWNRESAMPLER_API cc_bool ClownResampler_LowestLevel_Configure(ClownResampler_L
 	const cc_u32f kernel_scale = ClownResampler_CalculateRatio(input_sample_rate, actual_low_pass_sample_rate);
 	const cc_u32f inverse_kernel_scale = ClownResampler_CalculateRatio(actual_low_pass_sample_rate, input_sample_rate);
 
-	/* Bail on crazy ratios. */
-	/* TODO: Maybe use better ratio logic to raise this limit? */
-	if (kernel_scale >= CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(0x1000))
+	/* Bail on kernels that are empty, or so wide that their radius would overflow or their taps would overflow the
+	   accumulators. Sample rates of 0 are caught by this too, since 'ClownResampler_CalculateRatio' makes their scale huge. */
+	if (kernel_radius == 0 || kernel_resolution == 0 || kernel_radius > (size_t)-1 / kernel_scale || (size_t)kernel_radius * kernel_scale > CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)CLOWNRESAMPLER_MAXIMUM_STRETCHED_KERNEL_RADIUS))
+		return cc_false;
+
+#ifndef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+	/* Bail on kernels that are stretched so far that stepping through the kernel table would not move. */
+	if (CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(kernel_resolution, inverse_kernel_scale) == 0)
 		return cc_false;
+#endif
 
-	configuration->stretched_kernel_radius = CLOWNRESAMPLER_KERNEL_RADIUS * kernel_scale;
+	configuration->kernel_radius = kernel_radius;
+	configuration->kernel_resolution = kernel_resolution;
+	configuration->stretched_kernel_radius = kernel_radius * kernel_scale;
 	configuration->integer_stretched_kernel_radius = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(configuration->stretched_kernel_radius);
 	configuration->stretched_kernel_radius_delta = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(configuration->integer_stretched_kernel_radius) - configuration->stretched_kernel_radius;
 	CLOWNRESAMPLER_ASSERT(configuration->stretched_kernel_radius_delta < CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(1));
-	configuration->kernel_step_size = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(CLOWNRESAMPLER_KERNEL_RESOLUTION, inverse_kernel_scale);
+#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+	configuration->kernel_step_size = kernel_resolution * inverse_kernel_scale;
+#else
+	configuration->kernel_step_size = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(kernel_resolution, inverse_kernel_scale);
+#endif
 
 	/* The wider the kernel, the greater the number of taps, the louder the sample. */
 	/* Note that the scale is cast to 'long' here. This is to prevent samples from being promoted to
 	   'unsigned long' later on, which breaks their sign-extension. Also note that we convert from
 	   16.16 to 17.15 here. */
 	configuration->sample_normaliser = (cc_s32f)(inverse_kernel_scale >> (16 - 15));
+	configuration->normaliser_shift = 0;
+
+	/* The wider the kernel, the fewer significant bits the normaliser has, making the volume less accurate. To prevent
+	   this, the normaliser is given more fractional bits, and the accumulators are divided by the same amount to make
+	   room for them. The accumulators grow along with the kernel, so the bits that this discards are too small to matter.
+	   The normaliser is taken from the kernel step size instead of the sample rates, since the step size is rounded, and
+	   it is the step size that decides how many taps the kernel really has. */
+	if (configuration->sample_normaliser < 0x1000)
+	{
+#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+		const cc_u32f fraction = inverse_kernel_scale * CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+#else
+		const cc_u32f fraction = ClownResampler_CalculateFraction((cc_u32f)configuration->kernel_step_size, kernel_resolution);
+#endif
+
+		do
+		{
+			++configuration->normaliser_shift;
+			configuration->sample_normaliser = (cc_s32f)(fraction >> (32 - 15 - configuration->normaliser_shift));
+		} while (configuration->sample_normaliser < 0x1000 && configuration->normaliser_shift != 32 - 15);
+	}
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+	configuration->float_sample_normaliser = (float)((double)actual_low_pass_sample_rate / (double)input_sample_rate);
+#endif
+
+	/* When the kernel is stretched by exactly 1 or 2, the output frames that line up with an input frame have taps that
+	   fall exactly on the kernel's zero-crossings: with a factor of 1, every tap except the centre one does, and, with a
+	   factor of 2, every other tap does, making it a half-band filter. Those taps can be skipped. This only works if the
+	   kernel table has an entry for each of those taps. */
+	configuration->half_band_factor = 0;
+
+#ifndef CLOWNRESAMPLER_NO_HALF_BAND
+	if (kernel_scale == CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(1) || kernel_scale == CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(2))
+	{
+		const cc_u8f factor = (cc_u8f)CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(kernel_scale);
+
+ #ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+		if (configuration->kernel_step_size * factor == CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)kernel_resolution))
+ #else
+		if (configuration->kernel_step_size * factor == kernel_resolution)
+ #endif
+			configuration->half_band_factor = factor;
+	}
+#endif
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	/* The filter-bank is only used once 'ClownResampler_LowestLevel_ConfigurePolyphase' has made one. */
+	configuration->polyphase.total_phases = 0;
+	configuration->polyphase.bank = NULL;
+#endif
 
 	return cc_true;
 }
 
-CLOWNRESAMPLER_API void ClownResampler_LowestLevel_Resample(const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t position_integer, const cc_u32f position_fractional)
-{
-	cc_u8f current_channel;
-	size_t sample_index, kernel_index;
-
-	/* Calculate the bounds of the kernel convolution. */
-	const size_t min_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(position_fractional + configuration->stretched_kernel_radius_delta);
-	const size_t max_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position_fractional + configuration->stretched_kernel_radius);
-	const size_t min = (position_integer + min_relative) * channels;
-	const size_t max = (position_integer + configuration->integer_stretched_kernel_radius + max_relative) * channels;
+/* Multiplies a sample by a kernel value, for adding to a 'ClownResampler_Accumulator'. */
+#if defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR)
+#define CLOWNRESAMPLER_MULTIPLY_SAMPLE(sample, kernel_value) ((ClownResampler_Accumulator)(sample) * (kernel_value))
+#elif defined(CLOWNRESAMPLER_16_BIT_KERNEL)
+#define CLOWNRESAMPLER_MULTIPLY_SAMPLE(sample, kernel_value) ((sample) * (kernel_value) / CLOWNRESAMPLER_KERNEL_UNITY)
+/* Multiplies two samples by two kernel values, and adds the products together before rounding them, like 'pmaddwd' does.
+   Neither kernel value can be -1.0, so the sum always fits in 32 bits. */
+#define CLOWNRESAMPLER_MULTIPLY_SAMPLE_PAIR(sample_1, kernel_value_1, sample_2, kernel_value_2) (((sample_1) * (kernel_value_1) + (sample_2) * (kernel_value_2)) / CLOWNRESAMPLER_KERNEL_UNITY)
+#else
+#define CLOWNRESAMPLER_MULTIPLY_SAMPLE(sample, kernel_value) CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(sample, kernel_value)
+#endif
 
-	/* Yes, I know this line is insane.
-	   It is essentially a simplified and fixed-point version of this:
-	   const size_t kernel_start = (size_t)(configuration->kernel_step_size * ((float)(min / channels) - position_if_it_were_a_float)); */
-	const size_t kernel_start = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(configuration->kernel_step_size, (CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(min_relative) - position_fractional));
+static void ClownResampler_Accumulate_Scalar(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
 
-	CLOWNRESAMPLER_ASSERT(min_relative <= configuration->integer_stretched_kernel_radius);
-	CLOWNRESAMPLER_ASSERT(max_relative <= configuration->integer_stretched_kernel_radius);
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
 
-	for (sample_index = min, kernel_index = kernel_start; sample_index < max; sample_index += channels, kernel_index += configuration->kernel_step_size)
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+	/* The frames are done in pairs, to produce the same rounding as the SIMD routines. */
+	for (sample_index = 0, kernel_index = 0; sample_index + channels < total_samples; sample_index += channels * 2, kernel_index += kernel_step_size * 2)
 	{
-		cc_s32f kernel_value;
+		const cc_s32f kernel_value_1 = (cc_s32f)kernel[kernel_index];
+		const cc_s32f kernel_value_2 = (cc_s32f)kernel[kernel_index + kernel_step_size];
 
-		CLOWNRESAMPLER_ASSERT(kernel_index < CLOWNRESAMPLER_COUNT_OF(precomputed->lanczos_kernel_table));
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE_PAIR((cc_s32f)input_buffer[sample_index + current_channel], kernel_value_1, (cc_s32f)input_buffer[sample_index + channels + current_channel], kernel_value_2);
+	}
+#else
+	sample_index = 0;
+	kernel_index = 0;
+#endif
 
+	/* With 'CLOWNRESAMPLER_16_BIT_KERNEL', this is only the odd frame at the end, if there is one. */
+	for (; sample_index < total_samples; sample_index += channels, kernel_index += kernel_step_size)
+	{
 		/* The distance between the frames being output and the frames being read is the parameter to the Lanczos kernel. */
-		kernel_value = (cc_s32f)precomputed->lanczos_kernel_table[kernel_index];
+		const cc_s32f kernel_value = (cc_s32f)kernel[kernel_index];
 
 		/* Modulate the samples with the kernel and add them to the accumulators. */
 		for (current_channel = 0; current_channel < channels; ++current_channel)
-			output_frame[current_channel] += CLOWNRESAMPLER_FIXED_POINT_MULTIPLY((cc_s32f)input_buffer[sample_index + current_channel], kernel_value);
-	}
-
-	/* Normalise the samples. */
-	for (current_channel = 0; current_channel < channels; ++current_channel)
-	{
-		/* Note that we use a 17.15 version of CLOWNRESAMPLER_FIXED_POINT_MULTIPLY here.
-		   This is because, if we used a 16.16 normaliser, then there's a chance that the result
-		   of the multiplication would overflow, causing popping. */
-		output_frame[current_channel] = (output_frame[current_channel] * configuration->sample_normaliser) / (1 << 15);
+			output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[sample_index + current_channel], kernel_value);
 	}
 }
 
-#endif /* CLOWNRESAMPLER_GUARD_FUNCTION_DEFINITIONS */
-
-#ifndef CLOWNRESAMPLER_NO_LOW_LEVEL_API
-#define CLOWNRESAMPLER_NO_LOW_LEVEL_API
+static void ClownResampler_Convolve_Scalar(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	cc_u8f current_channel;
 
-/* Low-Level API */
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Init(ClownResampler_LowLevel_State* const resampler, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
-{
-	resampler->channels = channels;
-	resampler->position_integer = 0;
-	resampler->position_fractional = 0;
-	return ClownResampler_LowLevel_Adjust(resampler, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+	ClownResampler_Accumulate_Scalar(output_frame, channels, input_buffer, total_frames, kernel, kernel_step_size);
 }
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Adjust(ClownResampler_LowLevel_State* const resampler, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+static size_t ClownResampler_FixedPointMultiplyWide(const size_t a, const size_t b)
 {
-	resampler->increment = ClownResampler_CalculateRatio(input_sample_rate, output_sample_rate);
-	return ClownResampler_LowestLevel_Configure(&resampler->lowest_level, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+	/* Like 'CLOWNRESAMPLER_FIXED_POINT_MULTIPLY', but avoids overflowing when only the intermediate product is too large for 32 bits. */
+	const size_t a_integer = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(a);
+	const size_t a_fractional = a % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+	const size_t b_integer = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(b);
+	const size_t b_fractional = b % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+
+	return a * b_integer + a_integer * b_fractional + CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(a_fractional, b_fractional);
 }
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Resample(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+static cc_s32f ClownResampler_InterpolateKernel(const ClownResampler_Precomputed* const precomputed, const size_t kernel_position)
 {
-	for (;;)
+	/* 'kernel_position' is a 16.16 fixed point index into the full (non-symmetrical) kernel. */
+#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+	const size_t kernel_centre = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)precomputed->kernel_radius * precomputed->kernel_resolution);
+	const size_t distance = kernel_position < kernel_centre ? kernel_centre - kernel_position : kernel_position - kernel_centre;
+	const size_t position = CLOWNRESAMPLER_MIN(distance, kernel_centre - 1);
+#else
+	const size_t position = CLOWNRESAMPLER_MIN(kernel_position, CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)precomputed->kernel_radius * 2 * precomputed->kernel_resolution) - 1);
+#endif
+	const size_t index = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position);
+	/* Only 12 bits of the fraction are used, so that the multiplication below cannot overflow. */
+	const cc_s32f fraction = (cc_s32f)(position % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE >> 4);
+	const cc_s32f a = (cc_s32f)precomputed->lanczos_kernel_table[index];
+	const cc_s32f b = (cc_s32f)precomputed->lanczos_kernel_table[index + 1];
+
+	return a + (b - a) * fraction / (1 << 12);
+}
+#endif
+
+#if !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL) || defined(CLOWNRESAMPLER_POLYPHASE)
+/* Convolves the frames from 'first_frame' up to (but not including) 'last_frame'. 'input_buffer' only holds the frames
+   from 'input_start' up to 'input_end': any frames outside of that are silent, so they are skipped.
+   Returns 'cc_false' if every frame was skipped, in which case nothing is written to 'output_frame'. */
+static cc_bool ClownResampler_ConvolveWithinBounds(const ClownResampler_ConvolveFunction convolve, ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t first_frame, const size_t last_frame, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t start = CLOWNRESAMPLER_MAX(first_frame, input_start);
+	const size_t end = CLOWNRESAMPLER_MIN(last_frame, input_end);
+
+	if (start >= end)
+		return cc_false;
+
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+	/* The frames are multiplied in pairs, counting from 'first_frame', so skipping an odd number of frames would change
+	   how the products are rounded. Instead, the first frame is done alone, as if it were paired with a silent frame. */
+	if ((start - first_frame) % 2 != 0)
+	{
+		const cc_s16l* const frame = &input_buffer[(start - input_start) * channels];
+		const cc_s32f kernel_value = (cc_s32f)kernel[(ptrdiff_t)(start - first_frame) * kernel_step_size];
+
+		cc_u8f current_channel;
+
+		if (start + 1 != end)
+		{
+			convolve(output_frame, channels, frame + channels, end - start - 1, kernel + (ptrdiff_t)(start + 1 - first_frame) * kernel_step_size, kernel_step_size);
+		}
+		else
+		{
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				output_frame[current_channel] = 0;
+		}
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)frame[current_channel], kernel_value);
+
+		return cc_true;
+	}
+#endif
+
+	convolve(output_frame, channels, &input_buffer[(start - input_start) * channels], end - start, kernel + (ptrdiff_t)(start - first_frame) * kernel_step_size, kernel_step_size);
+	return cc_true;
+}
+#endif
+
+static void ClownResampler_NormaliseFrame(cc_s32f* const output_frame, const ClownResampler_Accumulator* const accumulators, const cc_u8f channels, const cc_s32f sample_normaliser, const cc_u8f normaliser_shift)
+{
+	cc_u8f current_channel;
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+	{
+		ClownResampler_Accumulator accumulator = accumulators[current_channel];
+
+		/* See 'ClownResampler_LowestLevel_Configure'. This is skipped when it is not needed, since dividing is slow. */
+		if (normaliser_shift != 0)
+			accumulator /= (ClownResampler_Accumulator)1 << normaliser_shift;
+
+#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+		/* The accumulators still hold the kernel's 16 fractional bits, so they are removed along with the normaliser's 15.
+		   The products add up to no more than 48 bits, so multiplying by the normaliser cannot overflow. */
+		output_frame[current_channel] = (cc_s32f)(accumulator * sample_normaliser / ((ClownResampler_Accumulator)1 << (16 + 15)));
+#else
+		/* Note that we use a 17.15 version of CLOWNRESAMPLER_FIXED_POINT_MULTIPLY here.
+		   This is because, if we used a 16.16 normaliser, then there's a chance that the result
+		   of the multiplication would overflow, causing popping. */
+		output_frame[current_channel] = (accumulator * sample_normaliser) / (1 << 15);
+#endif
+	}
+}
+
+/* Convolves an output frame that lines up exactly with input frame 'centre', using only the taps that do not fall on the
+   kernel's zero-crossings. 'configuration->half_band_factor' must not be 0. The output is not normalised. */
+static void ClownResampler_ConvolveHalfBand(const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t centre)
+{
+#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+	const size_t kernel_step_size = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(configuration->kernel_step_size);
+#else
+	const size_t kernel_step_size = configuration->kernel_step_size;
+#endif
+#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+	const ClownResampler_KernelValue* const kernel_centre = precomputed->lanczos_kernel_table;
+#else
+	const ClownResampler_KernelValue* const kernel_centre = &precomputed->lanczos_kernel_table[(size_t)precomputed->kernel_radius * precomputed->kernel_resolution];
+#endif
+
+	cc_u8f current_channel;
+	size_t distance;
+
+	/* The centre tap is always the peak of the kernel. */
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = centre >= input_start && centre < input_end ? CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[(centre - input_start) * channels + current_channel], CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM) : 0;
+
+	if (configuration->half_band_factor != 2)
+		return;
+
+	/* Only the taps at an odd distance from the centre are not 0. The frames on either side of the centre are done
+	   separately, in case the table is not quite symmetrical. */
+	for (distance = 1; distance < configuration->integer_stretched_kernel_radius; distance += 2)
+	{
+		const size_t before = centre - distance;
+		const size_t after = centre + distance;
+#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+		const cc_s32f kernel_value_before = (cc_s32f)kernel_centre[distance * kernel_step_size];
+#else
+		const cc_s32f kernel_value_before = (cc_s32f)kernel_centre[-(ptrdiff_t)(distance * kernel_step_size)];
+#endif
+		const cc_s32f kernel_value_after = (cc_s32f)kernel_centre[distance * kernel_step_size];
+
+		if (before >= input_start && before < input_end)
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[(before - input_start) * channels + current_channel], kernel_value_before);
+
+		if (after >= input_start && after < input_end)
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[(after - input_start) * channels + current_channel], kernel_value_after);
+	}
+}
+
+#if !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+/* Produces an output frame from the input frames from 'min' up to (but not including) 'max', which have already been
+   worked out from the position, along with the kernel value for 'min'. This is the second half of
+   'ClownResampler_ResampleFrame', which 'ClownResampler_ResampleFrames' also uses after working the bounds out itself.
+   Everything else is the same as 'ClownResampler_ResampleFrame'. */
+static void ClownResampler_ResampleFrameWithinBounds(const ClownResampler_ConvolveFunction convolve, const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t position_integer, const cc_u32f position_fractional, const size_t min, const size_t max, const ClownResampler_KernelValue* const kernel, const cc_s32f sample_normaliser)
+{
+	ClownResampler_Accumulator accumulators[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+	cc_u8f current_channel;
+
+	if (configuration->half_band_factor != 0 && position_fractional == 0)
+	{
+		ClownResampler_ConvolveHalfBand(configuration, precomputed, accumulators, channels, input_buffer, input_start, input_end, position_integer + configuration->integer_stretched_kernel_radius);
+	}
+	else if (!ClownResampler_ConvolveWithinBounds(convolve, accumulators, channels, input_buffer, input_start, input_end, min, max, kernel, (ptrdiff_t)configuration->kernel_step_size))
+	{
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			accumulators[current_channel] = 0;
+	}
+
+	ClownResampler_NormaliseFrame(output_frame, accumulators, channels, sample_normaliser, configuration->normaliser_shift);
+}
+#endif
+
+/* 'input_buffer' holds the frames from 'input_start' up to 'input_end', with the frames around them being treated as
+   silence. For a buffer that is padded in the way that the low-level API normally requires, these are 0 and (size_t)-1.
+   'sample_normaliser' is normally the configuration's, but it can be scaled to change the volume of the output for free. */
+static void ClownResampler_ResampleFrame(const ClownResampler_ConvolveFunction convolve, const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t position_integer, const cc_u32f position_fractional, const cc_s32f sample_normaliser)
+{
+#if defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) || defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	ClownResampler_Accumulator accumulators[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+	cc_u8f current_channel;
+#endif
+
+#if defined(CLOWNRESAMPLER_FIXED_TAPS) && !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	/* The kernel is centred on the frame that is 'integer_stretched_kernel_radius' frames after the position,
+	   and always spans the same number of frames, so the bounds do not depend on the fractional position.
+	   The frames at either end of the bounds may land on the padding around the kernel, which is silent. */
+	const size_t min = position_integer + 1;
+	const size_t max = min + configuration->integer_stretched_kernel_radius * 2;
+	/* This is one frame ahead of the start of the kernel, to keep it from being negative. */
+	const size_t kernel_start = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(configuration->kernel_step_size, CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(2) - position_fractional - configuration->stretched_kernel_radius_delta);
+#else
+	/* Calculate the bounds of the kernel convolution. */
+	const size_t min_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(position_fractional + configuration->stretched_kernel_radius_delta);
+	const size_t max_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position_fractional + configuration->stretched_kernel_radius);
+	const size_t min = position_integer + min_relative;
+	const size_t max = position_integer + configuration->integer_stretched_kernel_radius + max_relative;
+
+ #ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+	/* The same as below, except that the result is 16.16 fixed point. */
+	size_t kernel_position = ClownResampler_FixedPointMultiplyWide(configuration->kernel_step_size, CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(min_relative) - position_fractional);
+ #else
+	/* Yes, I know this line is insane.
+	   It is essentially a simplified and fixed-point version of this:
+	   const size_t kernel_start = (size_t)(configuration->kernel_step_size * ((float)min - position_if_it_were_a_float)); */
+	const size_t kernel_start = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(configuration->kernel_step_size, (CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(min_relative) - position_fractional));
+ #endif
+
+	CLOWNRESAMPLER_ASSERT(min_relative <= configuration->integer_stretched_kernel_radius);
+	CLOWNRESAMPLER_ASSERT(max_relative <= configuration->integer_stretched_kernel_radius);
+#endif
+
+	/* The configuration must have been made for this kernel. */
+	CLOWNRESAMPLER_ASSERT(precomputed->kernel_radius == configuration->kernel_radius && precomputed->kernel_resolution == configuration->kernel_resolution);
+
+#if defined(CLOWNRESAMPLER_FIXED_TAPS) && !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	/* The first frame may use the padding before the kernel, and the last frame may use the padding after it. */
+	CLOWNRESAMPLER_ASSERT(kernel_start <= configuration->kernel_step_size * 2);
+	CLOWNRESAMPLER_ASSERT(kernel_start + (max - min - 2) * configuration->kernel_step_size < ((size_t)precomputed->kernel_radius * 2 + 1) * precomputed->kernel_resolution);
+
+	ClownResampler_ResampleFrameWithinBounds(convolve, configuration, precomputed, output_frame, channels, input_buffer, input_start, input_end, position_integer, position_fractional, min, max, &precomputed->lanczos_kernel_table[kernel_start] - configuration->kernel_step_size, sample_normaliser);
+#elif !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	CLOWNRESAMPLER_ASSERT(max == min || kernel_start + (max - min - 1) * configuration->kernel_step_size < CLOWNRESAMPLER_KERNEL_TABLE_LENGTH((size_t)precomputed->kernel_radius, precomputed->kernel_resolution));
+
+	ClownResampler_ResampleFrameWithinBounds(convolve, configuration, precomputed, output_frame, channels, input_buffer, input_start, input_end, position_integer, position_fractional, min, max, &precomputed->lanczos_kernel_table[kernel_start], sample_normaliser);
+#else
+	if (configuration->half_band_factor != 0 && position_fractional == 0)
+	{
+		ClownResampler_ConvolveHalfBand(configuration, precomputed, accumulators, channels, input_buffer, input_start, input_end, position_integer + configuration->integer_stretched_kernel_radius);
+		ClownResampler_NormaliseFrame(output_frame, accumulators, channels, sample_normaliser, configuration->normaliser_shift);
+		return;
+	}
+
+ #if defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	{
+		/* The interpolated kernel values are produced in batches, which are then convolved as normal. */
+		/* Frames outside of the input buffer are silent, so skip them. */
+		const size_t start = CLOWNRESAMPLER_MAX(min, input_start);
+		const size_t end = CLOWNRESAMPLER_MAX(start, CLOWNRESAMPLER_MIN(max, input_end));
+		const size_t total_frames = end - start;
+
+		size_t frames_done;
+		ClownResampler_KernelValue kernel[0x40];
+		ClownResampler_Accumulator batch_output[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			accumulators[current_channel] = 0;
+
+		if (start > min)
+			kernel_position += (start - min) * configuration->kernel_step_size;
+
+		for (frames_done = 0; frames_done < total_frames; frames_done += CLOWNRESAMPLER_COUNT_OF(kernel))
+		{
+			const size_t frames_to_do = CLOWNRESAMPLER_MIN(CLOWNRESAMPLER_COUNT_OF(kernel), total_frames - frames_done);
+
+			size_t i;
+
+			for (i = 0; i < frames_to_do; ++i)
+			{
+				kernel[i] = (ClownResampler_KernelValue)ClownResampler_InterpolateKernel(precomputed, kernel_position);
+				kernel_position += configuration->kernel_step_size;
+			}
+
+			convolve(batch_output, channels, &input_buffer[(start - input_start + frames_done) * channels], frames_to_do, kernel, 1);
+
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				accumulators[current_channel] += batch_output[current_channel];
+		}
+	}
+ #else
+	CLOWNRESAMPLER_ASSERT(max == min || kernel_start + (max - min - 1) * configuration->kernel_step_size < (size_t)precomputed->kernel_radius * 2 * precomputed->kernel_resolution);
+
+	{
+		/* Only the second half of the kernel is stored, so the frames before the centre of the kernel
+		   must walk the table backwards, while the frames after it walk the table forwards. */
+		const size_t kernel_centre = (size_t)precomputed->kernel_radius * precomputed->kernel_resolution;
+		const size_t total_frames = max - min;
+		const size_t kernel_step_size = configuration->kernel_step_size;
+
+		size_t frames_before_centre;
+		ClownResampler_Accumulator half_output[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+		if (kernel_start >= kernel_centre)
+			frames_before_centre = 0;
+		else if (kernel_step_size == 0)
+			frames_before_centre = total_frames;
+		else
+			frames_before_centre = CLOWNRESAMPLER_MIN(total_frames, (kernel_centre - kernel_start + kernel_step_size - 1) / kernel_step_size);
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			accumulators[current_channel] = 0;
+
+		if (frames_before_centre != 0 && ClownResampler_ConvolveWithinBounds(convolve, half_output, channels, input_buffer, input_start, input_end, min, min + frames_before_centre, &precomputed->lanczos_kernel_table[kernel_centre - kernel_start], -(ptrdiff_t)kernel_step_size))
+		{
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				accumulators[current_channel] += half_output[current_channel];
+		}
+
+		if (frames_before_centre != total_frames && ClownResampler_ConvolveWithinBounds(convolve, half_output, channels, input_buffer, input_start, input_end, min + frames_before_centre, max, &precomputed->lanczos_kernel_table[kernel_start + frames_before_centre * kernel_step_size - kernel_centre], (ptrdiff_t)kernel_step_size))
+		{
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				accumulators[current_channel] += half_output[current_channel];
+		}
+	}
+ #endif
+
+	ClownResampler_NormaliseFrame(output_frame, accumulators, channels, sample_normaliser, configuration->normaliser_shift);
+#endif
+}
+
+CLOWNRESAMPLER_API void ClownResampler_LowestLevel_Resample(const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t position_integer, const cc_u32f position_fractional)
+{
+	ClownResampler_ResampleFrame(ClownResampler_Convolve_Scalar, configuration, precomputed, output_frame, channels, input_buffer, 0, (size_t)-1, position_integer, position_fractional, configuration->sample_normaliser);
+}
+
+#if !defined(CLOWNRESAMPLER_NO_LOW_LEVEL_API) && !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+/* The most output frames that 'ClownResampler_ResampleFrames' will produce from a single window of input frames. */
+#define CLOWNRESAMPLER_MAXIMUM_FRAMES_PER_WINDOW 8
+
+/* Produces 'total_kernels' consecutive output frames, which all convolve the frames from 'first_frame' up to (but not
+   including) 'last_frame', each with its own kernel. This is the same as doing 'ClownResampler_ConvolveWithinBounds'
+   and 'ClownResampler_NormaliseFrame' for each output frame, except that the input frames are only read once. */
+static void ClownResampler_ResampleWindow(const ClownResampler_ConvolveFunction convolve, const ClownResampler_ConvolveWindowFunction convolve_window, cc_s32f* const output_buffer, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t first_frame, const size_t last_frame, const ClownResampler_KernelValue* const* const kernels, const cc_u8f total_kernels, const ptrdiff_t kernel_step_size, const cc_s32f sample_normaliser, const cc_u8f normaliser_shift)
+{
+	const size_t start = CLOWNRESAMPLER_MAX(first_frame, input_start);
+	const size_t end = CLOWNRESAMPLER_MIN(last_frame, input_end);
+
+	ClownResampler_Accumulator accumulators[CLOWNRESAMPLER_MAXIMUM_FRAMES_PER_WINDOW * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+	cc_u8f current_kernel;
+
+	if (start >= end)
+	{
+		size_t i;
+
+		for (i = 0; i < (size_t)total_kernels * channels; ++i)
+			accumulators[i] = 0;
+	}
+	else if (total_kernels == 1)
+	{
+		/* There is nothing to share with a single output frame. */
+		convolve(accumulators, channels, &input_buffer[(start - input_start) * channels], end - start, kernels[0] + (ptrdiff_t)(start - first_frame) * kernel_step_size, kernel_step_size);
+	}
+	else
+	{
+		const ClownResampler_KernelValue *kernels_at_start[CLOWNRESAMPLER_MAXIMUM_FRAMES_PER_WINDOW];
+
+		for (current_kernel = 0; current_kernel < total_kernels; ++current_kernel)
+			kernels_at_start[current_kernel] = kernels[current_kernel] + (ptrdiff_t)(start - first_frame) * kernel_step_size;
+
+		convolve_window(accumulators, channels, &input_buffer[(start - input_start) * channels], end - start, kernels_at_start, total_kernels, kernel_step_size);
+	}
+
+	for (current_kernel = 0; current_kernel < total_kernels; ++current_kernel)
+		ClownResampler_NormaliseFrame(&output_buffer[current_kernel * channels], &accumulators[current_kernel * channels], channels, sample_normaliser, normaliser_shift);
+}
+#endif
+
+#ifndef CLOWNRESAMPLER_NO_LOW_LEVEL_API
+/* Resamples consecutive frames, advancing the position by 'increment' (16.16 fixed point) after each one, until either
+   'total_output_frames' frames have been produced or the position reaches 'total_input_frames'. The frames are the same
+   as those of 'ClownResampler_ResampleFrame', but, rather than the bounds of the kernel convolution being recalculated
+   from scratch for every frame, the kernel's phase is carried from one frame to the next, so that the position can be
+   advanced with a few additions. 'input_start' and 'input_end' are the same as they are for 'ClownResampler_ResampleFrame'.
+   Returns the number of frames produced. */
+static size_t ClownResampler_ResampleFrames(const ClownResampler_ConvolveFunction convolve, const ClownResampler_ConvolveWindowFunction convolve_window, const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_buffer, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, size_t* const position_integer_pointer, cc_u32f* const position_fractional_pointer, const cc_u32f increment, const cc_s32f sample_normaliser, const size_t total_output_frames)
+{
+	const size_t increment_integer = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(increment);
+	const cc_u32f increment_fractional = increment % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+
+	size_t position_integer = *position_integer_pointer;
+	cc_u32f position_fractional = *position_fractional_pointer;
+	size_t frames_done;
+
+#if !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	const size_t kernel_step_size = configuration->kernel_step_size;
+	const size_t kernel_phase_increment = kernel_step_size * increment_fractional;
+	const size_t kernel_phase_wrap = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(kernel_step_size);
+
+	/* This is 'kernel_step_size' multiplied by the distance between the position and the start of the kernel, in 16.16 fixed point.
+	   Subtracting it, rounded up, from a multiple of 'kernel_step_size' gives the same 'kernel_start' as 'ClownResampler_ResampleFrame'. */
+ #ifdef CLOWNRESAMPLER_FIXED_TAPS
+	size_t kernel_phase = kernel_step_size * (position_fractional + configuration->stretched_kernel_radius_delta);
+ #else
+	size_t kernel_phase = kernel_step_size * position_fractional;
+ #endif
+
+	/* Gathering output frames into windows only pays off when there are usually more than two of them per input frame. */
+	const cc_bool use_windows = convolve_window != NULL && increment < CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(1) / 2;
+	const ClownResampler_KernelValue *window_kernels[CLOWNRESAMPLER_MAXIMUM_FRAMES_PER_WINDOW];
+	cc_u8f window_frames = 0;
+	size_t window_min = 0, window_max = 0;
+
+	/* The configuration must have been made for this kernel. */
+	CLOWNRESAMPLER_ASSERT(precomputed->kernel_radius == configuration->kernel_radius && precomputed->kernel_resolution == configuration->kernel_resolution);
+#endif
+
+	CLOWNRESAMPLER_ASSERT(position_fractional < CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE);
+
+	for (frames_done = 0; frames_done < total_output_frames && position_integer < total_input_frames; ++frames_done)
+	{
+		cc_s32f* const output_frame = &output_buffer[frames_done * channels];
+
+#if defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) || defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+		/* These layouts do not index the kernel table linearly, so there is no phase to carry. */
+		ClownResampler_ResampleFrame(convolve, configuration, precomputed, output_frame, channels, input_buffer, input_start, input_end, position_integer, position_fractional, sample_normaliser);
+#else
+ #ifdef CLOWNRESAMPLER_FIXED_TAPS
+		const size_t min = position_integer + 1;
+		const size_t max = min + configuration->integer_stretched_kernel_radius * 2;
+		const ClownResampler_KernelValue* const kernel = &precomputed->lanczos_kernel_table[kernel_step_size * 2 - CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(kernel_phase)] - kernel_step_size;
+ #else
+		const size_t min_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(position_fractional + configuration->stretched_kernel_radius_delta);
+		const size_t max_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position_fractional + configuration->stretched_kernel_radius);
+		const size_t min = position_integer + min_relative;
+		const size_t max = position_integer + configuration->integer_stretched_kernel_radius + max_relative;
+		const ClownResampler_KernelValue* const kernel = &precomputed->lanczos_kernel_table[kernel_step_size * min_relative - CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(kernel_phase)];
+ #endif
+
+		const cc_bool use_half_band = configuration->half_band_factor != 0 && position_fractional == 0;
+
+		/* The window ends when an output frame needs different input frames to the ones before it. */
+		if (window_frames != 0 && (use_half_band || min != window_min || max != window_max || window_frames == CLOWNRESAMPLER_MAXIMUM_FRAMES_PER_WINDOW))
+		{
+			ClownResampler_ResampleWindow(convolve, convolve_window, &output_buffer[(frames_done - window_frames) * channels], channels, input_buffer, input_start, input_end, window_min, window_max, window_kernels, window_frames, (ptrdiff_t)kernel_step_size, sample_normaliser, configuration->normaliser_shift);
+			window_frames = 0;
+		}
+
+		if (use_windows && !use_half_band)
+		{
+			window_min = min;
+			window_max = max;
+			window_kernels[window_frames++] = kernel;
+		}
+		else
+		{
+			ClownResampler_ResampleFrameWithinBounds(convolve, configuration, precomputed, output_frame, channels, input_buffer, input_start, input_end, position_integer, position_fractional, min, max, kernel, sample_normaliser);
+		}
+
+		kernel_phase += kernel_phase_increment;
+#endif
+
+		position_integer += increment_integer;
+		position_fractional += increment_fractional;
+
+		if (position_fractional >= CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE)
+		{
+			position_fractional -= CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+			++position_integer;
+#if !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+			kernel_phase -= kernel_phase_wrap;
+#endif
+		}
+	}
+
+#if !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+	if (window_frames != 0)
+		ClownResampler_ResampleWindow(convolve, convolve_window, &output_buffer[(frames_done - window_frames) * channels], channels, input_buffer, input_start, input_end, window_min, window_max, window_kernels, window_frames, (ptrdiff_t)kernel_step_size, sample_normaliser, configuration->normaliser_shift);
+#else
+	(void)convolve_window;
+#endif
+
+	*position_integer_pointer = position_integer;
+	*position_fractional_pointer = position_fractional;
+
+	return frames_done;
+}
+#endif
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* 'input_start' and 'input_end' are the same as they are for 'ClownResampler_ResampleFrame'. */
+static void ClownResampler_ResampleFramePolyphase(const ClownResampler_ConvolveFunction convolve, const ClownResampler_LowestLevel_Configuration* const configuration, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t position_integer, const cc_u32f phase)
+{
+	const size_t total_taps = configuration->integer_stretched_kernel_radius * 2;
+
+	ClownResampler_Accumulator accumulators[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+	cc_u8f current_channel;
+
+	CLOWNRESAMPLER_ASSERT(phase < configuration->polyphase.total_phases);
+
+	/* The coefficients are already normalised, so there is nothing else to do. */
+	if (!ClownResampler_ConvolveWithinBounds(convolve, accumulators, channels, input_buffer, input_start, input_end, position_integer, position_integer + total_taps, &configuration->polyphase.bank[phase * total_taps], 1))
+	{
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			accumulators[current_channel] = 0;
+	}
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+	{
+#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+		output_frame[current_channel] = (cc_s32f)(accumulators[current_channel] / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE);
+#else
+		output_frame[current_channel] = accumulators[current_channel];
+#endif
+	}
+}
+
+CLOWNRESAMPLER_API void ClownResampler_LowestLevel_ResamplePolyphase(const ClownResampler_LowestLevel_Configuration* const configuration, cc_s32f* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t position_integer, const cc_u32f phase)
+{
+	ClownResampler_ResampleFramePolyphase(ClownResampler_Convolve_Scalar, configuration, output_frame, channels, input_buffer, 0, (size_t)-1, position_integer, phase);
+}
+#endif
+
+#endif /* CLOWNRESAMPLER_GUARD_FUNCTION_DEFINITIONS */
+
+#ifndef CLOWNRESAMPLER_NO_LOW_LEVEL_API
+#define CLOWNRESAMPLER_NO_LOW_LEVEL_API
+
+/* Low-Level API */
+
+#if !defined(CLOWNRESAMPLER_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+ #define CLOWNRESAMPLER_X86_SIMD
+ #define CLOWNRESAMPLER_TARGET(x) __attribute__((target(x)))
+ #include <immintrin.h>
+#elif !defined(CLOWNRESAMPLER_NO_SIMD) && defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #define CLOWNRESAMPLER_X86_SIMD
+ #define CLOWNRESAMPLER_TARGET(x)
+ #include <immintrin.h>
+ #include <intrin.h>
+#endif
+
+/* Like 'ClownResampler_Accumulate_Scalar', 16-bit kernels are done in pairs of frames, leaving the odd frame at the end. */
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+#define CLOWNRESAMPLER_CONVOLVE_SCALAR_PAIRS(TOTAL_CHANNELS) \
+	for (; sample_index + TOTAL_CHANNELS < total_samples; sample_index += TOTAL_CHANNELS * 2, kernel_index += kernel_step_size * 2) \
+	{ \
+		const cc_s32f kernel_value_1 = (cc_s32f)kernel[kernel_index]; \
+		const cc_s32f kernel_value_2 = (cc_s32f)kernel[kernel_index + kernel_step_size]; \
+\
+		for (current_channel = 0; current_channel < TOTAL_CHANNELS; ++current_channel) \
+			accumulators[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE_PAIR((cc_s32f)input_buffer[sample_index + current_channel], kernel_value_1, (cc_s32f)input_buffer[sample_index + TOTAL_CHANNELS + current_channel], kernel_value_2); \
+	}
+#else
+#define CLOWNRESAMPLER_CONVOLVE_SCALAR_PAIRS(TOTAL_CHANNELS)
+#endif
+
+/* Versions of 'ClownResampler_Convolve_Scalar' for specific numbers of channels. Knowing the number of channels
+   in advance allows the compiler to unroll the channel loop and keep the accumulators in registers. */
+#define CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR(TOTAL_CHANNELS) \
+static void ClownResampler_Convolve_Scalar##TOTAL_CHANNELS(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size) \
+{ \
+	const size_t total_samples = total_frames * TOTAL_CHANNELS; \
+\
+	ClownResampler_Accumulator accumulators[TOTAL_CHANNELS]; \
+	cc_u8f current_channel; \
+	size_t sample_index; \
+	ptrdiff_t kernel_index; \
+\
+	(void)channels; \
+\
+	for (current_channel = 0; current_channel < TOTAL_CHANNELS; ++current_channel) \
+		accumulators[current_channel] = 0; \
+\
+	sample_index = 0; \
+	kernel_index = 0; \
+\
+	CLOWNRESAMPLER_CONVOLVE_SCALAR_PAIRS(TOTAL_CHANNELS) \
+\
+	for (; sample_index < total_samples; sample_index += TOTAL_CHANNELS, kernel_index += kernel_step_size) \
+	{ \
+		const cc_s32f kernel_value = (cc_s32f)kernel[kernel_index]; \
+\
+		for (current_channel = 0; current_channel < TOTAL_CHANNELS; ++current_channel) \
+			accumulators[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[sample_index + current_channel], kernel_value); \
+	} \
+\
+	for (current_channel = 0; current_channel < TOTAL_CHANNELS; ++current_channel) \
+		output_frame[current_channel] = accumulators[current_channel]; \
+}
+
+CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR(1) /* Mono. */
+CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR(2) /* Stereo. */
+CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR(6) /* 5.1 surround. */
+CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR(8) /* 7.1 surround. */
+
+#undef CLOWNRESAMPLER_DEFINE_CONVOLVE_SCALAR
+#undef CLOWNRESAMPLER_CONVOLVE_SCALAR_PAIRS
+
+#ifdef CLOWNRESAMPLER_X86_SIMD
+/* These produce exactly the same output as 'ClownResampler_Convolve_Scalar'. This works because a 16-bit sample
+   multiplied by a 16.16 kernel value always fits in 32 bits, as does the sum of the resulting products. With
+   'CLOWNRESAMPLER_16_BIT_KERNEL', the samples stay 16-bit, and are multiplied in pairs of frames. */
+
+#ifndef CLOWNRESAMPLER_16_BIT_KERNEL
+static CLOWNRESAMPLER_TARGET("sse2") __m128i ClownResampler_LoadSamples_SSE2(const cc_s16l* const samples)
+{
+	/* Load four samples and sign-extend them to 32 bits. */
+	const __m128i words = _mm_loadl_epi64((const __m128i*)samples);
+
+	return _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+}
+#endif
+
+#if defined(CLOWNRESAMPLER_16_BIT_KERNEL)
+static CLOWNRESAMPLER_TARGET("sse2") __m128i ClownResampler_MultiplyPairs_SSE2(const __m128i samples, const __m128i kernel)
+{
+	/* Multiply each pair of samples by a pair of kernel values, and add the two products together. */
+	const __m128i products = _mm_madd_epi16(samples, kernel);
+
+	/* Round towards zero, like C's division does. */
+	return _mm_srai_epi32(_mm_add_epi32(products, _mm_and_si128(_mm_srai_epi32(products, 31), _mm_set1_epi32(0x7FFF))), 15);
+}
+
+static CLOWNRESAMPLER_TARGET("sse2") void ClownResampler_Convolve_SSE2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+	int lanes[4];
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 4)
+	{
+		/* With fewer than four channels, each vector holds multiple frames. */
+		__m128i accumulator = _mm_setzero_si128();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 8)
+			{
+				const __m128i kernel_values = _mm_set_epi16((short)kernel[kernel_index + kernel_step_size * 7], (short)kernel[kernel_index + kernel_step_size * 6], (short)kernel[kernel_index + kernel_step_size * 5], (short)kernel[kernel_index + kernel_step_size * 4], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index]);
+
+				accumulator = _mm_add_epi32(accumulator, ClownResampler_MultiplyPairs_SSE2(_mm_loadu_si128((const __m128i*)&input_buffer[sample_index]), kernel_values));
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 4)
+			{
+				/* Swap the middle samples of each pair of frames, so that each channel's samples are next to each other. */
+				const __m128i samples = _mm_shufflehi_epi16(_mm_shufflelo_epi16(_mm_loadu_si128((const __m128i*)&input_buffer[sample_index]), _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+				const __m128i kernel_values = _mm_set_epi16((short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index]);
+
+				accumulator = _mm_add_epi32(accumulator, ClownResampler_MultiplyPairs_SSE2(samples, kernel_values));
+			}
+		}
+
+		_mm_storeu_si128((__m128i*)lanes, accumulator);
+
+		for (current_channel = 0; current_channel < 4; ++current_channel)
+			output_frame[current_channel % channels] += lanes[current_channel];
+
+		/* Do the leftover frames. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+	else
+	{
+		/* With four or more channels, each vector holds four channels of a pair of frames. */
+		const cc_u8f vector_channels = channels / 4 * 4;
+
+		__m128i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 3) / 4];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			accumulators[current_channel / 4] = _mm_setzero_si128();
+
+		for (sample_index = 0, kernel_index = 0; sample_index + channels < total_samples; sample_index += channels * 2, kernel_index += kernel_step_size * 2)
+		{
+			const __m128i kernel_values = _mm_unpacklo_epi16(_mm_set1_epi16((short)kernel[kernel_index]), _mm_set1_epi16((short)kernel[kernel_index + kernel_step_size]));
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			{
+				/* Interleave the two frames, so that each channel's samples are next to each other. */
+				const __m128i samples = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)&input_buffer[sample_index + current_channel]), _mm_loadl_epi64((const __m128i*)&input_buffer[sample_index + channels + current_channel]));
+
+				accumulators[current_channel / 4] = _mm_add_epi32(accumulators[current_channel / 4], ClownResampler_MultiplyPairs_SSE2(samples, kernel_values));
+			}
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE_PAIR((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index], (cc_s32f)input_buffer[sample_index + channels + current_channel], (cc_s32f)kernel[kernel_index + kernel_step_size]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+		{
+			cc_u8f i;
+
+			_mm_storeu_si128((__m128i*)lanes, accumulators[current_channel / 4]);
+
+			for (i = 0; i < 4; ++i)
+				output_frame[current_channel + i] += lanes[i];
+		}
+
+		/* Do the leftover frame. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+}
+#elif defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR)
+static CLOWNRESAMPLER_TARGET("sse4.1") void ClownResampler_MultiplyAccumulate_SSE41(__m128i* const accumulators, const __m128i samples, const __m128i kernel)
+{
+	/* Only the even lanes can be multiplied into 64-bit products, so the odd lanes are shifted down and done separately. */
+	accumulators[0] = _mm_add_epi64(accumulators[0], _mm_mul_epi32(samples, kernel));
+	accumulators[1] = _mm_add_epi64(accumulators[1], _mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(kernel, 32)));
+}
+
+/* Adds the four lanes of a pair of accumulators to 'output_frame', wrapping around after 'channels'. */
+static CLOWNRESAMPLER_TARGET("sse4.1") void ClownResampler_StoreAccumulators_SSE41(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const __m128i* const accumulators)
+{
+	ClownResampler_Accumulator lanes[2][2];
+	cc_u8f i;
+
+	_mm_storeu_si128((__m128i*)lanes[0], accumulators[0]);
+	_mm_storeu_si128((__m128i*)lanes[1], accumulators[1]);
+
+	for (i = 0; i < 4; ++i)
+		output_frame[i % channels] += lanes[i % 2][i / 2];
+}
+
+static CLOWNRESAMPLER_TARGET("sse4.1") void ClownResampler_Convolve_SSE41(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 4)
+	{
+		/* With fewer than four channels, each vector holds multiple frames. */
+		__m128i accumulators[2];
+
+		accumulators[0] = accumulators[1] = _mm_setzero_si128();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 4 <= total_samples; sample_index += 4, kernel_index += kernel_step_size * 4)
+			{
+				const __m128i kernel_values = _mm_set_epi32((int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index]);
+
+				ClownResampler_MultiplyAccumulate_SSE41(accumulators, ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index]), kernel_values);
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 4 <= total_samples; sample_index += 4, kernel_index += kernel_step_size * 2)
+			{
+				const __m128i kernel_values = _mm_set_epi32((int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				ClownResampler_MultiplyAccumulate_SSE41(accumulators, ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index]), kernel_values);
+			}
+		}
+
+		ClownResampler_StoreAccumulators_SSE41(output_frame, channels, accumulators);
+
+		/* Do the leftover frames. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+	else
+	{
+		/* With four or more channels, each vector holds four channels of a single frame. */
+		const cc_u8f vector_channels = channels / 4 * 4;
+
+		__m128i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 3) / 4][2];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			accumulators[current_channel / 4][0] = accumulators[current_channel / 4][1] = _mm_setzero_si128();
+
+		for (sample_index = 0, kernel_index = 0; sample_index < total_samples; sample_index += channels, kernel_index += kernel_step_size)
+		{
+			const __m128i kernel_value = _mm_set1_epi32((int)kernel[kernel_index]);
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+				ClownResampler_MultiplyAccumulate_SSE41(accumulators[current_channel / 4], ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index + current_channel]), kernel_value);
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			ClownResampler_StoreAccumulators_SSE41(&output_frame[current_channel], 4, accumulators[current_channel / 4]);
+	}
+}
+#else
+static CLOWNRESAMPLER_TARGET("sse2") __m128i ClownResampler_FixedPointMultiply_SSE2(const __m128i samples, const __m128i kernel)
+{
+	/* SSE2 lacks a 32-bit multiply, so multiply the even and odd lanes separately and then combine their lower halves. */
+	const __m128i even_products = _mm_mul_epu32(samples, kernel);
+	const __m128i odd_products = _mm_mul_epu32(_mm_srli_si128(samples, 4), _mm_srli_si128(kernel, 4));
+	const __m128i products = _mm_unpacklo_epi32(_mm_shuffle_epi32(even_products, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd_products, _MM_SHUFFLE(0, 0, 2, 0)));
+
+	/* Round towards zero, like C's division does. */
+	return _mm_srai_epi32(_mm_add_epi32(products, _mm_and_si128(_mm_srai_epi32(products, 31), _mm_set1_epi32(0xFFFF))), 16);
+}
+
+static CLOWNRESAMPLER_TARGET("sse2") void ClownResampler_Convolve_SSE2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+	int lanes[4];
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 4)
+	{
+		/* With fewer than four channels, each vector holds multiple frames. */
+		__m128i accumulator = _mm_setzero_si128();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 4 <= total_samples; sample_index += 4, kernel_index += kernel_step_size * 4)
+			{
+				const __m128i kernel_values = _mm_set_epi32((int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index]);
+
+				accumulator = _mm_add_epi32(accumulator, ClownResampler_FixedPointMultiply_SSE2(ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index]), kernel_values));
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 4 <= total_samples; sample_index += 4, kernel_index += kernel_step_size * 2)
+			{
+				const __m128i kernel_values = _mm_set_epi32((int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				accumulator = _mm_add_epi32(accumulator, ClownResampler_FixedPointMultiply_SSE2(ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index]), kernel_values));
+			}
+		}
+
+		_mm_storeu_si128((__m128i*)lanes, accumulator);
+
+		for (current_channel = 0; current_channel < 4; ++current_channel)
+			output_frame[current_channel % channels] += lanes[current_channel];
+
+		/* Do the leftover frames. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+	else
+	{
+		/* With four or more channels, each vector holds four channels of a single frame. */
+		const cc_u8f vector_channels = channels / 4 * 4;
+
+		__m128i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 3) / 4];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			accumulators[current_channel / 4] = _mm_setzero_si128();
+
+		for (sample_index = 0, kernel_index = 0; sample_index < total_samples; sample_index += channels, kernel_index += kernel_step_size)
+		{
+			const __m128i kernel_value = _mm_set1_epi32((int)kernel[kernel_index]);
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+				accumulators[current_channel / 4] = _mm_add_epi32(accumulators[current_channel / 4], ClownResampler_FixedPointMultiply_SSE2(ClownResampler_LoadSamples_SSE2(&input_buffer[sample_index + current_channel]), kernel_value));
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_FIXED_POINT_MULTIPLY((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+		{
+			cc_u8f i;
+
+			_mm_storeu_si128((__m128i*)lanes, accumulators[current_channel / 4]);
+
+			for (i = 0; i < 4; ++i)
+				output_frame[current_channel + i] += lanes[i];
+		}
+	}
+}
+#endif
+
+#ifndef CLOWNRESAMPLER_NO_AVX2
+#ifndef CLOWNRESAMPLER_16_BIT_KERNEL
+static CLOWNRESAMPLER_TARGET("avx2") __m256i ClownResampler_LoadSamples_AVX2(const cc_s16l* const samples)
+{
+	/* Load eight samples and sign-extend them to 32 bits. */
+	return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)samples));
+}
+#endif
+
+#if defined(CLOWNRESAMPLER_16_BIT_KERNEL)
+static CLOWNRESAMPLER_TARGET("avx2") __m256i ClownResampler_MultiplyPairs_AVX2(const __m256i samples, const __m256i kernel)
+{
+	/* Multiply each pair of samples by a pair of kernel values, and add the two products together. */
+	const __m256i products = _mm256_madd_epi16(samples, kernel);
+
+	/* Round towards zero, like C's division does. */
+	return _mm256_srai_epi32(_mm256_add_epi32(products, _mm256_and_si256(_mm256_srai_epi32(products, 31), _mm256_set1_epi32(0x7FFF))), 15);
+}
+
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_Convolve_AVX2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+	int lanes[8];
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 8 && channels != 1 && channels != 2 && channels != 4)
+	{
+		/* Pairs of these frames do not fit evenly into a vector, so leave them to the SSE2 routine. */
+		ClownResampler_Convolve_SSE2(output_frame, channels, input_buffer, total_frames, kernel, kernel_step_size);
+		return;
+	}
+
+	if (channels < 8)
+	{
+		/* With fewer than eight channels, each vector holds multiple frames. */
+		__m256i accumulator = _mm256_setzero_si256();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 16 <= total_samples; sample_index += 16, kernel_index += kernel_step_size * 16)
+			{
+				const __m256i kernel_values = _mm256_set_epi16((short)kernel[kernel_index + kernel_step_size * 15], (short)kernel[kernel_index + kernel_step_size * 14], (short)kernel[kernel_index + kernel_step_size * 13], (short)kernel[kernel_index + kernel_step_size * 12], (short)kernel[kernel_index + kernel_step_size * 11], (short)kernel[kernel_index + kernel_step_size * 10], (short)kernel[kernel_index + kernel_step_size * 9], (short)kernel[kernel_index + kernel_step_size * 8], (short)kernel[kernel_index + kernel_step_size * 7], (short)kernel[kernel_index + kernel_step_size * 6], (short)kernel[kernel_index + kernel_step_size * 5], (short)kernel[kernel_index + kernel_step_size * 4], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_MultiplyPairs_AVX2(_mm256_loadu_si256((const __m256i*)&input_buffer[sample_index]), kernel_values));
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 16 <= total_samples; sample_index += 16, kernel_index += kernel_step_size * 8)
+			{
+				/* Swap the middle samples of each pair of frames, so that each channel's samples are next to each other. */
+				const __m256i samples = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(_mm256_loadu_si256((const __m256i*)&input_buffer[sample_index]), _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+				const __m256i kernel_values = _mm256_set_epi16((short)kernel[kernel_index + kernel_step_size * 7], (short)kernel[kernel_index + kernel_step_size * 6], (short)kernel[kernel_index + kernel_step_size * 7], (short)kernel[kernel_index + kernel_step_size * 6], (short)kernel[kernel_index + kernel_step_size * 5], (short)kernel[kernel_index + kernel_step_size * 4], (short)kernel[kernel_index + kernel_step_size * 5], (short)kernel[kernel_index + kernel_step_size * 4], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_MultiplyPairs_AVX2(samples, kernel_values));
+			}
+		}
+		else if (channels == 4)
+		{
+			/* Interleaves the two frames in each half of the vector, so that each channel's samples are next to each other. */
+			const __m256i interleave = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15, 0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+
+			for (; sample_index + 16 <= total_samples; sample_index += 16, kernel_index += kernel_step_size * 4)
+			{
+				const __m256i samples = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)&input_buffer[sample_index]), interleave);
+				const __m256i kernel_values = _mm256_set_epi16((short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size * 3], (short)kernel[kernel_index + kernel_step_size * 2], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index], (short)kernel[kernel_index + kernel_step_size], (short)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_MultiplyPairs_AVX2(samples, kernel_values));
+			}
+		}
+
+		_mm256_storeu_si256((__m256i*)lanes, accumulator);
+
+		for (current_channel = 0; current_channel < 8; ++current_channel)
+			output_frame[current_channel % channels] += lanes[current_channel];
+	}
+	else
+	{
+		/* With eight or more channels, each vector holds eight channels of a pair of frames. */
+		const cc_u8f vector_channels = channels / 8 * 8;
+
+		__m256i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 7) / 8];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+			accumulators[current_channel / 8] = _mm256_setzero_si256();
+
+		for (sample_index = 0, kernel_index = 0; sample_index + channels < total_samples; sample_index += channels * 2, kernel_index += kernel_step_size * 2)
+		{
+			const __m256i kernel_values = _mm256_unpacklo_epi16(_mm256_set1_epi16((short)kernel[kernel_index]), _mm256_set1_epi16((short)kernel[kernel_index + kernel_step_size]));
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+			{
+				/* Interleave the two frames, so that each channel's samples are next to each other. */
+				const __m128i first_frame = _mm_loadu_si128((const __m128i*)&input_buffer[sample_index + current_channel]);
+				const __m128i second_frame = _mm_loadu_si128((const __m128i*)&input_buffer[sample_index + channels + current_channel]);
+				const __m256i samples = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(first_frame, second_frame)), _mm_unpackhi_epi16(first_frame, second_frame), 1);
+
+				accumulators[current_channel / 8] = _mm256_add_epi32(accumulators[current_channel / 8], ClownResampler_MultiplyPairs_AVX2(samples, kernel_values));
+			}
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE_PAIR((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index], (cc_s32f)input_buffer[sample_index + channels + current_channel], (cc_s32f)kernel[kernel_index + kernel_step_size]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+		{
+			cc_u8f i;
+
+			_mm256_storeu_si256((__m256i*)lanes, accumulators[current_channel / 8]);
+
+			for (i = 0; i < 8; ++i)
+				output_frame[current_channel + i] += lanes[i];
+		}
+	}
+
+	/* The leftover frames are done by a function that was not compiled for AVX, so the upper halves of the
+	   registers must be cleared first, otherwise every SSE instruction that it uses will be very slow. */
+	_mm256_zeroupper();
+
+	/* Do the leftover frames. */
+	ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+}
+#elif defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR)
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_MultiplyAccumulate_AVX2(__m256i* const accumulators, const __m256i samples, const __m256i kernel)
+{
+	/* Only the even lanes can be multiplied into 64-bit products, so the odd lanes are shifted down and done separately. */
+	accumulators[0] = _mm256_add_epi64(accumulators[0], _mm256_mul_epi32(samples, kernel));
+	accumulators[1] = _mm256_add_epi64(accumulators[1], _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), _mm256_srli_epi64(kernel, 32)));
+}
+
+/* Adds the eight lanes of a pair of accumulators to 'output_frame', wrapping around after 'channels'. */
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_StoreAccumulators_AVX2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const __m256i* const accumulators)
+{
+	ClownResampler_Accumulator lanes[2][4];
+	cc_u8f i;
+
+	_mm256_storeu_si256((__m256i*)lanes[0], accumulators[0]);
+	_mm256_storeu_si256((__m256i*)lanes[1], accumulators[1]);
+
+	for (i = 0; i < 8; ++i)
+		output_frame[i % channels] += lanes[i % 2][i / 2];
+}
+
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_Convolve_AVX2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 8)
+	{
+		/* With fewer than eight channels, each vector holds multiple frames. */
+		__m256i accumulators[2];
+
+		accumulators[0] = accumulators[1] = _mm256_setzero_si256();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 8)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size * 7], (int)kernel[kernel_index + kernel_step_size * 6], (int)kernel[kernel_index + kernel_step_size * 5], (int)kernel[kernel_index + kernel_step_size * 4], (int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index]);
+
+				ClownResampler_MultiplyAccumulate_AVX2(accumulators, ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values);
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 4)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				ClownResampler_MultiplyAccumulate_AVX2(accumulators, ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values);
+			}
+		}
+		else if (channels == 4)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 2)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				ClownResampler_MultiplyAccumulate_AVX2(accumulators, ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values);
+			}
+		}
+
+		ClownResampler_StoreAccumulators_AVX2(output_frame, channels, accumulators);
+
+		/* The leftover frames are done by a function that was not compiled for AVX, so the upper halves of the
+		   registers must be cleared first, otherwise every SSE instruction that it uses will be very slow. */
+		_mm256_zeroupper();
+
+		/* Do the leftover frames. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+	else
+	{
+		/* With eight or more channels, each vector holds eight channels of a single frame. */
+		const cc_u8f vector_channels = channels / 8 * 8;
+
+		__m256i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 7) / 8][2];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+			accumulators[current_channel / 8][0] = accumulators[current_channel / 8][1] = _mm256_setzero_si256();
+
+		for (sample_index = 0, kernel_index = 0; sample_index < total_samples; sample_index += channels, kernel_index += kernel_step_size)
+		{
+			const __m256i kernel_value = _mm256_set1_epi32((int)kernel[kernel_index]);
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+				ClownResampler_MultiplyAccumulate_AVX2(accumulators[current_channel / 8], ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index + current_channel]), kernel_value);
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_MULTIPLY_SAMPLE((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+			ClownResampler_StoreAccumulators_AVX2(&output_frame[current_channel], 8, accumulators[current_channel / 8]);
+	}
+}
+#else
+static CLOWNRESAMPLER_TARGET("avx2") __m256i ClownResampler_FixedPointMultiply_AVX2(const __m256i samples, const __m256i kernel)
+{
+	const __m256i products = _mm256_mullo_epi32(samples, kernel);
+
+	/* Round towards zero, like C's division does. */
+	return _mm256_srai_epi32(_mm256_add_epi32(products, _mm256_and_si256(_mm256_srai_epi32(products, 31), _mm256_set1_epi32(0xFFFF))), 16);
+}
+
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_Convolve_AVX2(ClownResampler_Accumulator* const output_frame, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const kernel, const ptrdiff_t kernel_step_size)
+{
+	const size_t total_samples = total_frames * channels;
+
+	cc_u8f current_channel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+	int lanes[8];
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0;
+
+	if (channels < 8)
+	{
+		/* With fewer than eight channels, each vector holds multiple frames. */
+		__m256i accumulator = _mm256_setzero_si256();
+
+		sample_index = 0;
+		kernel_index = 0;
+
+		if (channels == 1)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 8)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size * 7], (int)kernel[kernel_index + kernel_step_size * 6], (int)kernel[kernel_index + kernel_step_size * 5], (int)kernel[kernel_index + kernel_step_size * 4], (int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_FixedPointMultiply_AVX2(ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values));
+			}
+		}
+		else if (channels == 2)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 4)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 3], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size * 2], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_FixedPointMultiply_AVX2(ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values));
+			}
+		}
+		else if (channels == 4)
+		{
+			for (; sample_index + 8 <= total_samples; sample_index += 8, kernel_index += kernel_step_size * 2)
+			{
+				const __m256i kernel_values = _mm256_set_epi32((int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index + kernel_step_size], (int)kernel[kernel_index], (int)kernel[kernel_index], (int)kernel[kernel_index], (int)kernel[kernel_index]);
+
+				accumulator = _mm256_add_epi32(accumulator, ClownResampler_FixedPointMultiply_AVX2(ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index]), kernel_values));
+			}
+		}
+
+		_mm256_storeu_si256((__m256i*)lanes, accumulator);
+
+		/* The leftover frames are done by a function that was not compiled for AVX, so the upper halves of the
+		   registers must be cleared first, otherwise every SSE instruction that it uses will be very slow. */
+		_mm256_zeroupper();
+
+		for (current_channel = 0; current_channel < 8; ++current_channel)
+			output_frame[current_channel % channels] += lanes[current_channel];
+
+		/* Do the leftover frames. */
+		ClownResampler_Accumulate_Scalar(output_frame, channels, &input_buffer[sample_index], total_frames - sample_index / channels, &kernel[kernel_index], kernel_step_size);
+	}
+	else
+	{
+		/* With eight or more channels, each vector holds eight channels of a single frame. */
+		const cc_u8f vector_channels = channels / 8 * 8;
+
+		__m256i accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 7) / 8];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+			accumulators[current_channel / 8] = _mm256_setzero_si256();
+
+		for (sample_index = 0, kernel_index = 0; sample_index < total_samples; sample_index += channels, kernel_index += kernel_step_size)
+		{
+			const __m256i kernel_value = _mm256_set1_epi32((int)kernel[kernel_index]);
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+				accumulators[current_channel / 8] = _mm256_add_epi32(accumulators[current_channel / 8], ClownResampler_FixedPointMultiply_AVX2(ClownResampler_LoadSamples_AVX2(&input_buffer[sample_index + current_channel]), kernel_value));
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += CLOWNRESAMPLER_FIXED_POINT_MULTIPLY((cc_s32f)input_buffer[sample_index + current_channel], (cc_s32f)kernel[kernel_index]);
+		}
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 8)
+		{
+			cc_u8f i;
+
+			_mm256_storeu_si256((__m256i*)lanes, accumulators[current_channel / 8]);
+
+			for (i = 0; i < 8; ++i)
+				output_frame[current_channel + i] += lanes[i];
+		}
+	}
+}
+
+/* Each lane holds a different output frame, so that each sample is multiplied by every kernel at once. */
+static CLOWNRESAMPLER_TARGET("avx2") void ClownResampler_ConvolveWindow_AVX2(ClownResampler_Accumulator* const output_frames, const cc_u8f channels, const cc_s16l* const input_buffer, const size_t total_frames, const ClownResampler_KernelValue* const* const kernels, const cc_u8f total_kernels, const ptrdiff_t kernel_step_size)
+{
+	const ClownResampler_KernelValue *lane_kernels[8];
+	__m256i accumulators[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+	cc_u8f current_channel, current_kernel;
+	size_t sample_index;
+	ptrdiff_t kernel_index;
+	int lanes[8];
+
+	CLOWNRESAMPLER_ASSERT(total_kernels <= 8);
+
+	/* The spare lanes reuse the first kernel, and are discarded at the end. */
+	for (current_kernel = 0; current_kernel < 8; ++current_kernel)
+		lane_kernels[current_kernel] = kernels[current_kernel < total_kernels ? current_kernel : 0];
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		accumulators[current_channel] = _mm256_setzero_si256();
+
+	for (sample_index = 0, kernel_index = 0; sample_index < total_frames * channels; sample_index += channels, kernel_index += kernel_step_size)
+	{
+		const __m256i kernel_values = _mm256_set_epi32((int)lane_kernels[7][kernel_index], (int)lane_kernels[6][kernel_index], (int)lane_kernels[5][kernel_index], (int)lane_kernels[4][kernel_index], (int)lane_kernels[3][kernel_index], (int)lane_kernels[2][kernel_index], (int)lane_kernels[1][kernel_index], (int)lane_kernels[0][kernel_index]);
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			accumulators[current_channel] = _mm256_add_epi32(accumulators[current_channel], ClownResampler_FixedPointMultiply_AVX2(_mm256_set1_epi32(input_buffer[sample_index + current_channel]), kernel_values));
+	}
+
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+	{
+		_mm256_storeu_si256((__m256i*)lanes, accumulators[current_channel]);
+
+		for (current_kernel = 0; current_kernel < total_kernels; ++current_kernel)
+			output_frames[current_kernel * channels + current_channel] = lanes[current_kernel];
+	}
+}
+#endif
+#endif
+
+#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+static cc_bool ClownResampler_CPUSupportsSSE41(void)
+{
+#ifdef _MSC_VER
+	int info[4];
+
+	__cpuid(info, 1);
+	return (info[2] & (1 << 19)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse4.1") != 0;
+#endif
+}
+#endif
+
+/* The floating-point API uses this too. */
+#if !defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR) || !defined(CLOWNRESAMPLER_NO_FLOAT_API)
+static cc_bool ClownResampler_CPUSupportsSSE2(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	/* SSE2 is a baseline feature of x86-64. */
+	return cc_true;
+#elif defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+#endif
+
+#ifndef CLOWNRESAMPLER_NO_AVX2
+static cc_bool ClownResampler_CPUSupportsAVX2(void)
+{
+#ifdef _MSC_VER
+	int info[4];
+
+	/* Check for AVX support from both the CPU and the OS (XSAVE must be enabled, and must preserve the YMM registers). */
+	__cpuid(info, 1);
+
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+		return cc_false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+#endif /* CLOWNRESAMPLER_X86_SIMD */
+
+static ClownResampler_ConvolveFunction ClownResampler_SelectConvolveFunction(const cc_u8f channels)
+{
+#ifdef CLOWNRESAMPLER_X86_SIMD
+	/* The SIMD routines load samples as 16-bit integers, and the wide ones store their accumulators as 64-bit integers. */
+#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+	if (sizeof(cc_s16l) == 2 && sizeof(ClownResampler_Accumulator) == 8)
+#else
+	if (sizeof(cc_s16l) == 2)
+#endif
+	{
+	#ifndef CLOWNRESAMPLER_NO_AVX2
+	#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+		/* This leaves the channel counts that it cannot do to the SSE2 routine itself, which every AVX2 CPU supports. */
+		if (ClownResampler_CPUSupportsAVX2())
+	#else
+		if ((channels == 1 || channels == 2 || channels == 4 || channels >= 8) && ClownResampler_CPUSupportsAVX2())
+	#endif
+			return ClownResampler_Convolve_AVX2;
+	#endif
+
+	#ifdef CLOWNRESAMPLER_WIDE_ACCUMULATOR
+		if ((channels == 1 || channels == 2 || channels >= 4) && ClownResampler_CPUSupportsSSE41())
+			return ClownResampler_Convolve_SSE41;
+	#else
+		if ((channels == 1 || channels == 2 || channels >= 4) && ClownResampler_CPUSupportsSSE2())
+			return ClownResampler_Convolve_SSE2;
+	#endif
+	}
+#endif
+
+	switch (channels)
+	{
+		case 1:
+			return ClownResampler_Convolve_Scalar1;
+
+		case 2:
+			return ClownResampler_Convolve_Scalar2;
+
+		case 6:
+			return ClownResampler_Convolve_Scalar6;
+
+		case 8:
+			return ClownResampler_Convolve_Scalar8;
+
+		default:
+			return ClownResampler_Convolve_Scalar;
+	}
+}
+
+static ClownResampler_ConvolveWindowFunction ClownResampler_SelectConvolveWindowFunction(void)
+{
+#if defined(CLOWNRESAMPLER_X86_SIMD) && !defined(CLOWNRESAMPLER_NO_AVX2) && !defined(CLOWNRESAMPLER_WIDE_ACCUMULATOR) && !defined(CLOWNRESAMPLER_16_BIT_KERNEL)
+	if (ClownResampler_CPUSupportsAVX2())
+		return ClownResampler_ConvolveWindow_AVX2;
+#endif
+
+	/* Without SIMD, this is no faster than convolving each output frame separately. */
+	return NULL;
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Init(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	resampler->lowest_level.kernel_radius = precomputed->kernel_radius;
+	resampler->lowest_level.kernel_resolution = precomputed->kernel_resolution;
+	resampler->convolve = ClownResampler_SelectConvolveFunction(channels);
+	resampler->convolve_window = ClownResampler_SelectConvolveWindowFunction();
+	resampler->channels = channels;
+	resampler->position_integer = 0;
+	resampler->position_fractional = 0;
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	resampler->position_phase = 0;
+	resampler->polyphase_bank = NULL;
+	resampler->polyphase_bank_length = 0;
+	resampler->lowest_level.polyphase.total_phases = 0;
+#endif
+	return ClownResampler_LowLevel_Adjust(resampler, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+}
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* Converts the position from a phase to 16.16 fixed point, before the filter-bank is remade with different phases (or
+   none at all). This rounds upwards, so that converting back to the same phases is lossless. */
+static void ClownResampler_LowLevel_LeavePolyphase(ClownResampler_LowLevel_State* const resampler)
+{
+	const cc_u32f total_phases = resampler->lowest_level.polyphase.total_phases;
+
+	if (total_phases != 0)
+		resampler->position_fractional = (CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(resampler->position_phase) + total_phases - 1) / total_phases;
+}
+
+/* Makes the filter-bank for the rates that were last passed to 'ClownResampler_LowLevel_Adjust', if the resampler has
+   been given a buffer for it, and converts the position to the filter-bank's phases. */
+static void ClownResampler_LowLevel_EnterPolyphase(ClownResampler_LowLevel_State* const resampler)
+{
+	if (resampler->polyphase_bank == NULL || !ClownResampler_LowestLevel_ConfigurePolyphase(&resampler->lowest_level, resampler->polyphase_bank, resampler->polyphase_bank_length, resampler->input_sample_rate, resampler->output_sample_rate, resampler->low_pass_filter_sample_rate))
+		return;
+
+	resampler->position_phase = resampler->position_fractional * resampler->lowest_level.polyphase.total_phases / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_LowLevel_SetPolyphaseBank(ClownResampler_LowLevel_State* const resampler, ClownResampler_KernelValue* const bank, const size_t bank_length)
+{
+	ClownResampler_LowLevel_LeavePolyphase(resampler);
+	resampler->lowest_level.polyphase.total_phases = 0;
+	resampler->lowest_level.polyphase.bank = NULL;
+	resampler->polyphase_bank = bank;
+	resampler->polyphase_bank_length = bank_length;
+	ClownResampler_LowLevel_EnterPolyphase(resampler);
+}
+#endif
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Adjust(ClownResampler_LowLevel_State* const resampler, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	cc_bool success;
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	ClownResampler_LowLevel_LeavePolyphase(resampler);
+#endif
+
+	resampler->increment = ClownResampler_CalculateRatio(input_sample_rate, output_sample_rate);
+	success = ClownResampler_LowestLevel_Configure(&resampler->lowest_level, resampler->lowest_level.kernel_radius, resampler->lowest_level.kernel_resolution, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (success)
+	{
+		resampler->input_sample_rate = input_sample_rate;
+		resampler->output_sample_rate = output_sample_rate;
+		resampler->low_pass_filter_sample_rate = low_pass_filter_sample_rate;
+		ClownResampler_LowLevel_EnterPolyphase(resampler);
+	}
+#endif
+
+	/* When the sample rates match and the kernel is not stretched at all, every output frame lines up with an input
+	   frame, and every tap other than the centre one lands on one of the kernel's zero-crossings, so the input can just
+	   be copied to the output. This relies on the same conditions as the half-band path. */
+	resampler->passthrough = resampler->increment == CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(1) && resampler->lowest_level.half_band_factor == 1;
+
+	return success;
+}
+
+/* Calculates the position that the resampler will be at after producing 'output_frame' frames from the start of the
+   input, as 'ClownResampler_LowLevel_ResampleNextFrame' would arrive at it. */
+static size_t ClownResampler_LowLevel_GetPosition(const ClownResampler_LowLevel_State* const resampler, const size_t output_frame, cc_u32f* const position_fractional)
+{
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+	{
+		/* Every frame advances the position by 'increment_integer' frames and 'increment_phase' phases.
+		   The phases are multiplied in two parts, so that the multiplication cannot overflow: 'output_frame / total_phases'
+		   is multiplied as a 'size_t', and the remainder and 'increment_phase' are both below 'total_phases', which
+		   'ClownResampler_LowestLevel_ConfigurePolyphase' limits to 0xFFFF, so their product fits in a 'cc_u32f'. */
+		const cc_u32f total_phases = resampler->lowest_level.polyphase.total_phases;
+		const cc_u32f increment_phase = resampler->lowest_level.polyphase.increment_phase;
+		const cc_u32f remaining_phases = (cc_u32f)(output_frame % total_phases) * increment_phase;
+
+		*position_fractional = remaining_phases % total_phases;
+		return output_frame * resampler->lowest_level.polyphase.increment_integer + output_frame / total_phases * increment_phase + remaining_phases / total_phases;
+	}
+	else
+#endif
+	{
+		/* This is 'output_frame' multiplied by the 16.16 increment, with the increment's fractional part being
+		   multiplied in two parts, so that the multiplication cannot overflow. */
+		const cc_u32f increment_fractional = resampler->increment % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+		const cc_u32f lower_product = (cc_u32f)(output_frame % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE) * increment_fractional;
+
+		*position_fractional = lower_product % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+		return output_frame * CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(resampler->increment) + output_frame / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE * increment_fractional + CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(lower_product);
+	}
+}
+
+/* Returns the part of the position that comes after its integer part, which is what the functions below mean by
+   'position_fractional': the phase while the polyphase filter-bank is being used, and the 16.16 fraction otherwise. */
+static cc_u32f* ClownResampler_LowLevel_GetPositionFractional(ClownResampler_LowLevel_State* const resampler)
+{
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+		return &resampler->position_phase;
+#endif
+
+	return &resampler->position_fractional;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_LowLevel_Seek(ClownResampler_LowLevel_State* const resampler, const size_t output_frame)
+{
+	resampler->position_integer = ClownResampler_LowLevel_GetPosition(resampler, output_frame, ClownResampler_LowLevel_GetPositionFractional(resampler));
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_GetTotalOutputFrames(const ClownResampler_LowLevel_State* const resampler, const size_t total_input_frames)
+{
+	/* Find the first output frame that is positioned at or after the end of the input.
+	   The position only ever increases, so this is done by doubling until it is passed, and then bisecting. */
+	size_t lower = 0, upper = 1;
+	cc_u32f position_fractional;
+
+	while (ClownResampler_LowLevel_GetPosition(resampler, upper, &position_fractional) < total_input_frames)
+	{
+		lower = upper;
+		upper *= 2;
+	}
+
+	while (lower != upper)
+	{
+		const size_t middle = lower + (upper - lower) / 2;
+
+		if (ClownResampler_LowLevel_GetPosition(resampler, middle, &position_fractional) < total_input_frames)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+
+	return lower;
+}
+
+/* Finds the input frame that is copied to the output frame at 'position_integer' when passing through, which is the one
+   at the centre of the kernel. Returns a pointer to it, or NULL if it is outside of the input buffer, and so is silent.
+   'input_buffer' can be of any sample type, and 'frame_size' is the size of its frames in bytes. The other parameters
+   are the same as those of 'ClownResampler_LowLevel_ResampleFramesToBuffer'. */
+static const void* ClownResampler_LowLevel_GetPassthroughFrame(const ClownResampler_LowLevel_State* const resampler, const size_t position_integer, const void* const input_buffer, const size_t frame_size, const size_t input_start, const size_t input_end)
+{
+	const size_t centre = position_integer + resampler->lowest_level.integer_stretched_kernel_radius;
+
+	CLOWNRESAMPLER_ASSERT(resampler->passthrough);
+
+	if (centre < input_start || centre >= input_end)
+		return NULL;
+
+	return &((const unsigned char*)input_buffer)[(centre - input_start) * frame_size];
+}
+
+/* Returns the normaliser (17.15 fixed point) with 'gain' folded into it. Every path applies the gain this way, so that
+   they all keep the same precision. The polyphase filter-bank's coefficients are already normalised, so its normaliser
+   is 1.0, and the result is applied to its output frames instead. */
+static cc_s32f ClownResampler_LowLevel_GetGainNormaliser(const ClownResampler_LowLevel_State* const resampler, const cc_u32f gain)
+{
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+		return (cc_s32f)CLOWNRESAMPLER_FIXED_POINT_MULTIPLY((cc_u32f)1 << 15, gain);
+#endif
+
+	return (cc_s32f)CLOWNRESAMPLER_FIXED_POINT_MULTIPLY((cc_u32f)resampler->lowest_level.sample_normaliser, gain);
+}
+
+/* Copies frames from the input to the output, for when the input and output sample rates match and there is nothing to
+   filter. This produces exactly the same output as convolving would, since every tap other than the centre one lands on
+   one of the kernel's zero-crossings, and the centre one is the kernel's peak. That is 1.0, except with a 16-bit kernel,
+   which cannot hold 1.0, so the samples are scaled by its peak as they would be by the convolution. The position must
+   be a whole number of frames, so only its integer part is needed. The parameters are the same as those of 'ClownResampler_LowLevel_ResampleFramesToBuffer'. */
+static size_t ClownResampler_LowLevel_CopyFrames(const ClownResampler_LowLevel_State* const resampler, size_t* const position_integer, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, cc_s32f* const s32_output_buffer, cc_s16l* const s16_output_buffer, const cc_bool mix, const cc_u32f gain, const size_t total_output_frames)
+{
+	const cc_u8f channels = resampler->channels;
+	const size_t total_frames = *position_integer >= total_input_frames ? 0 : CLOWNRESAMPLER_MIN(total_output_frames, total_input_frames - *position_integer);
+
+	/* Apply the gain in the same way that 'ClownResampler_LowLevel_ResampleNextFrame' would. */
+	const cc_s32f gain_normaliser = ClownResampler_LowLevel_GetGainNormaliser(resampler, gain);
+
+	size_t i;
+
+	for (i = 0; i < total_frames; ++i)
+	{
+		const cc_s16l* const input_frame = (const cc_s16l*)ClownResampler_LowLevel_GetPassthroughFrame(resampler, *position_integer + i, input_buffer, channels * sizeof(*input_buffer), input_start, input_end);
+		const size_t output_index = i * channels;
+
+		cc_u8f current_channel;
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+		{
+			cc_s32f sample = input_frame == NULL ? 0 : (cc_s32f)input_frame[current_channel];
+
+#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+			sample = (cc_s32f)CLOWNRESAMPLER_MULTIPLY_SAMPLE(sample, CLOWNRESAMPLER_KERNEL_VALUE_MAXIMUM);
+#endif
+
+			if (gain != CLOWNRESAMPLER_GAIN_UNITY)
+				sample = sample * gain_normaliser / (1 << 15);
+
+			if (mix)
+				s32_output_buffer[output_index + current_channel] += sample;
+			else if (s32_output_buffer != NULL)
+				s32_output_buffer[output_index + current_channel] = sample;
+			else
+				s16_output_buffer[output_index + current_channel] = (cc_s16l)sample;
+		}
+	}
+
+	*position_integer += total_frames;
+
+	return total_frames;
+}
+
+/* Moves the position to that of the next output frame. */
+static void ClownResampler_LowLevel_AdvancePosition(const ClownResampler_LowLevel_State* const resampler, size_t* const position_integer, cc_u32f* const position_fractional)
+{
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+	{
+		*position_fractional += resampler->lowest_level.polyphase.increment_phase;
+		*position_integer += resampler->lowest_level.polyphase.increment_integer;
+
+		if (*position_fractional >= resampler->lowest_level.polyphase.total_phases)
+		{
+			*position_fractional -= resampler->lowest_level.polyphase.total_phases;
+			++*position_integer;
+		}
+	}
+	else
+#endif
+	{
+		*position_fractional += resampler->increment;
+		*position_integer += CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(*position_fractional);
+		*position_fractional %= CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+	}
+}
+
+/* Resamples the frame at the position, and then advances the position. The position is passed separately from the
+   resampler, so that the resampler does not have to be modified.
+   'gain' is 16.16 fixed point, and must not be greater than 'CLOWNRESAMPLER_GAIN_UNITY'. */
+static void ClownResampler_LowLevel_ResampleNextFrame(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, size_t* const position_integer, cc_u32f* const position_fractional, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const cc_u32f gain, cc_s32f* const output_frame)
+{
+	CLOWNRESAMPLER_ASSERT(gain <= CLOWNRESAMPLER_GAIN_UNITY);
+
+	if (resampler->passthrough && *position_fractional == 0)
+	{
+		ClownResampler_LowLevel_CopyFrames(resampler, position_integer, input_buffer, input_start, input_end, (size_t)-1, output_frame, NULL, cc_false, gain, 1);
+		return;
+	}
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+	{
+		ClownResampler_ResampleFramePolyphase(resampler->convolve, &resampler->lowest_level, output_frame, resampler->channels, input_buffer, input_start, input_end, *position_integer, *position_fractional);
+
+		/* The coefficients have the normaliser baked into them, so the gain has to be applied separately. */
+		if (gain != CLOWNRESAMPLER_GAIN_UNITY)
+		{
+			const cc_s32f gain_normaliser = ClownResampler_LowLevel_GetGainNormaliser(resampler, gain);
+
+			cc_u8f current_channel;
+
+			for (current_channel = 0; current_channel < resampler->channels; ++current_channel)
+				output_frame[current_channel] = output_frame[current_channel] * gain_normaliser / (1 << 15);
+		}
+	}
+	else
+#endif
+	{
+		/* The gain is folded into the normaliser, so that it costs nothing per sample. */
+		ClownResampler_ResampleFrame(resampler->convolve, &resampler->lowest_level, precomputed, output_frame, resampler->channels, input_buffer, input_start, input_end, *position_integer, *position_fractional, ClownResampler_LowLevel_GetGainNormaliser(resampler, gain));
+	}
+
+	ClownResampler_LowLevel_AdvancePosition(resampler, position_integer, position_fractional);
+}
+
+/* Resamples frames and advances the position past them, until either 'total_output_frames' frames have been produced or the
+   position reaches 'total_input_frames'. This is the same as calling 'ClownResampler_LowLevel_ResampleNextFrame' repeatedly,
+   except that the position is advanced in bulk where possible. 'input_start' and 'input_end' are the same as they are for
+   'ClownResampler_ResampleFrame'. Returns the number of frames produced. */
+static size_t ClownResampler_LowLevel_ResampleNextFrames(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, size_t* const position_integer, cc_u32f* const position_fractional, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, const cc_u32f gain, cc_s32f* const output_buffer, const size_t total_output_frames)
+{
+	CLOWNRESAMPLER_ASSERT(gain <= CLOWNRESAMPLER_GAIN_UNITY);
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	if (resampler->lowest_level.polyphase.total_phases != 0)
+	{
+		size_t frames_done;
+
+		for (frames_done = 0; frames_done < total_output_frames && *position_integer < total_input_frames; ++frames_done)
+			ClownResampler_LowLevel_ResampleNextFrame(resampler, precomputed, position_integer, position_fractional, input_buffer, input_start, input_end, gain, &output_buffer[frames_done * resampler->channels]);
+
+		return frames_done;
+	}
+	else
+#endif
+	{
+		/* The gain is folded into the normaliser, so that it costs nothing per sample. */
+		return ClownResampler_ResampleFrames(resampler->convolve, resampler->convolve_window, &resampler->lowest_level, precomputed, output_buffer, resampler->channels, input_buffer, input_start, input_end, total_input_frames, position_integer, position_fractional, resampler->increment, ClownResampler_LowLevel_GetGainNormaliser(resampler, gain), total_output_frames);
+	}
+}
+
+/* Produces frames until either the output buffer is full or the position reaches 'total_input_frames'.
+   'input_start' and 'input_end' are the same as they are for 'ClownResampler_ResampleFrame'.
+   The position is advanced past the frames, in the same way as 'ClownResampler_LowLevel_ResampleNextFrame' does.
+   Only one of 's32_output_buffer' and 's16_output_buffer' should be non-NULL.
+   If 'mix' is 'cc_true', then the frames are added to 's32_output_buffer' instead of overwriting it. */
+static size_t ClownResampler_LowLevel_ResampleFramesToBuffer(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, size_t* const position_integer, cc_u32f* const position_fractional, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, cc_s32f* const s32_output_buffer, cc_s16l* const s16_output_buffer, const cc_bool mix, const cc_u32f gain, const size_t total_output_frames)
+{
+	size_t frames_done;
+
+	if (resampler->passthrough && *position_fractional == 0)
+		return ClownResampler_LowLevel_CopyFrames(resampler, position_integer, input_buffer, input_start, input_end, total_input_frames, s32_output_buffer, s16_output_buffer, mix, gain, total_output_frames);
+
+	/* Frames that are not written straight to the output buffer are produced in batches. */
+	if (!mix && s32_output_buffer != NULL)
+		return ClownResampler_LowLevel_ResampleNextFrames(resampler, precomputed, position_integer, position_fractional, input_buffer, input_start, input_end, total_input_frames, gain, s32_output_buffer, total_output_frames);
+
+	frames_done = 0;
+
+	while (frames_done < total_output_frames)
+	{
+		cc_s32f samples[0x20 * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+		size_t frames_in_batch, i;
+
+		frames_in_batch = ClownResampler_LowLevel_ResampleNextFrames(resampler, precomputed, position_integer, position_fractional, input_buffer, input_start, input_end, total_input_frames, gain, samples, CLOWNRESAMPLER_MIN(0x20, total_output_frames - frames_done));
+
+		if (frames_in_batch == 0)
+			break;
+
+		for (i = 0; i < frames_in_batch * resampler->channels; ++i)
+		{
+			if (mix)
+				s32_output_buffer[frames_done * resampler->channels + i] += samples[i];
+			else
+				s16_output_buffer[frames_done * resampler->channels + i] = (cc_s16l)CLOWNRESAMPLER_CLAMP(-0x7FFF - 1, 0x7FFF, samples[i]);
+		}
+
+		frames_done += frames_in_batch;
+	}
+
+	return frames_done;
+}
+
+/* Produces frames until either the output callback returns 0 or the position reaches 'total_input_frames'.
+   'input_start' and 'input_end' are the same as they are for 'ClownResampler_ResampleFrame'.
+   Returns 'cc_true' if the input ran out, and 'cc_false' if the output callback returned 0. */
+static cc_bool ClownResampler_LowLevel_ResampleFramesToCallback(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+{
+	/* Check if we have reached the end of the input buffer. */
+	while (resampler->position_integer < total_input_frames)
+	{
+		cc_s32f samples[CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+		ClownResampler_LowLevel_ResampleNextFrame(resampler, precomputed, &resampler->position_integer, ClownResampler_LowLevel_GetPositionFractional(resampler), input_buffer, input_start, input_end, CLOWNRESAMPLER_GAIN_UNITY, samples);
+
+		/* Output the samples. */
+		if (!output_callback((void*)user_data, samples, resampler->channels))
+		{
+			/* We've reached the end of the output buffer. */
+			return cc_false;
+		}
+	}
+
+	return cc_true;
+}
+
+/* Discards the input frames that have been passed. */
+static void ClownResampler_LowLevel_DiscardInput(ClownResampler_LowLevel_State* const resampler, size_t* const total_input_frames)
+{
+	const size_t delta = CLOWNRESAMPLER_MIN(resampler->position_integer, *total_input_frames);
+
+	*total_input_frames -= delta;
+	resampler->position_integer -= delta;
+}
+
+/* The parameters are the same as those of 'ClownResampler_LowLevel_ResampleFramesToBuffer'. */
+static size_t ClownResampler_LowLevel_ResampleToBuffer(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, cc_s32f* const s32_output_buffer, cc_s16l* const s16_output_buffer, const cc_bool mix, const cc_u32f gain, const size_t total_output_frames)
+{
+	/* The input buffer is padded, so there is no need to check the bounds of the kernel. */
+	const size_t frames_done = ClownResampler_LowLevel_ResampleFramesToBuffer(resampler, precomputed, &resampler->position_integer, ClownResampler_LowLevel_GetPositionFractional(resampler), input_buffer, 0, (size_t)-1, *total_input_frames, s32_output_buffer, s16_output_buffer, mix, gain, total_output_frames);
+
+	ClownResampler_LowLevel_DiscardInput(resampler, total_input_frames);
+
+	return frames_done;
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_Resample(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+{
+	/* The input buffer is padded, so there is no need to check the bounds of the kernel. */
+	const cc_bool reached_end_of_input = ClownResampler_LowLevel_ResampleFramesToCallback(resampler, precomputed, input_buffer, 0, (size_t)-1, *total_input_frames, output_callback, user_data);
+
+	ClownResampler_LowLevel_DiscardInput(resampler, total_input_frames);
+
+	return reached_end_of_input;
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToS32(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, cc_s32f* const output_buffer, const size_t total_output_frames)
+{
+	return ClownResampler_LowLevel_ResampleToBuffer(resampler, precomputed, input_buffer, total_input_frames, output_buffer, NULL, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToS16(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, cc_s16l* const output_buffer, const size_t total_output_frames)
+{
+	return ClownResampler_LowLevel_ResampleToBuffer(resampler, precomputed, input_buffer, total_input_frames, NULL, output_buffer, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_MixToS32(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, size_t* const total_input_frames, cc_s32f* const output_buffer, const size_t total_output_frames, const cc_u32f gain)
+{
+	return ClownResampler_LowLevel_ResampleToBuffer(resampler, precomputed, input_buffer, total_input_frames, output_buffer, NULL, cc_true, gain, total_output_frames);
+}
+
+/* Only one of 's32_output_buffer' and 's16_output_buffer' should be non-NULL. */
+static size_t ClownResampler_LowLevel_ResampleChunkToBuffer(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, const size_t first_output_frame, cc_s32f* const s32_output_buffer, cc_s16l* const s16_output_buffer, const size_t total_output_frames)
+{
+	/* The chunk has its own position, so that many threads can share the same resampler. */
+	cc_u32f position_fractional;
+	size_t position_integer = ClownResampler_LowLevel_GetPosition(resampler, first_output_frame, &position_fractional);
+
+	/* The input buffer is padded, so there is no need to check the bounds of the kernel. */
+	return ClownResampler_LowLevel_ResampleFramesToBuffer(resampler, precomputed, &position_integer, &position_fractional, input_buffer, 0, (size_t)-1, total_input_frames, s32_output_buffer, s16_output_buffer, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleChunkToS32(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, const size_t first_output_frame, cc_s32f* const output_buffer, const size_t total_output_frames)
+{
+	return ClownResampler_LowLevel_ResampleChunkToBuffer(resampler, precomputed, input_buffer, total_input_frames, first_output_frame, output_buffer, NULL, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleChunkToS16(const ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, const size_t first_output_frame, cc_s16l* const output_buffer, const size_t total_output_frames)
+{
+	return ClownResampler_LowLevel_ResampleChunkToBuffer(resampler, precomputed, input_buffer, total_input_frames, first_output_frame, NULL, output_buffer, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_GetChunk(const ClownResampler_LowLevel_State* const resampler, const size_t total_input_frames, const size_t total_chunks, const size_t chunk_index, size_t* const first_output_frame)
+{
+	const size_t total_output_frames = ClownResampler_LowLevel_GetTotalOutputFrames(resampler, total_input_frames);
+
+	/* The frames that do not divide evenly are given to the first chunks, one each. */
+	const size_t frames_per_chunk = total_output_frames / total_chunks;
+	const size_t leftover_frames = total_output_frames % total_chunks;
+
+	*first_output_frame = chunk_index * frames_per_chunk + CLOWNRESAMPLER_MIN(chunk_index, leftover_frames);
+	return frames_per_chunk + (chunk_index < leftover_frames ? 1 : 0);
+}
+
+/* In an unpadded buffer, the frames of the padding are missing, so the frames within the buffer start after them.
+   The kernel's bounds are checked, and any frames that it covers outside of the buffer are treated as silence. */
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_ResampleUnpadded(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+{
+	const size_t padding_frames = resampler->lowest_level.integer_stretched_kernel_radius;
+
+	return ClownResampler_LowLevel_ResampleFramesToCallback(resampler, precomputed, input_buffer, padding_frames, padding_frames + total_input_frames, total_input_frames, output_callback, user_data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToS32(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, cc_s32f* const output_buffer, const size_t total_output_frames)
+{
+	const size_t padding_frames = resampler->lowest_level.integer_stretched_kernel_radius;
+
+	return ClownResampler_LowLevel_ResampleFramesToBuffer(resampler, precomputed, &resampler->position_integer, ClownResampler_LowLevel_GetPositionFractional(resampler), input_buffer, padding_frames, padding_frames + total_input_frames, total_input_frames, output_buffer, NULL, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToS16(ClownResampler_LowLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_s16l* const input_buffer, const size_t total_input_frames, cc_s16l* const output_buffer, const size_t total_output_frames)
+{
+	const size_t padding_frames = resampler->lowest_level.integer_stretched_kernel_radius;
+
+	return ClownResampler_LowLevel_ResampleFramesToBuffer(resampler, precomputed, &resampler->position_integer, ClownResampler_LowLevel_GetPositionFractional(resampler), input_buffer, padding_frames, padding_frames + total_input_frames, total_input_frames, NULL, output_buffer, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames);
+}
+
+/* Input Buffers */
+
+/* These manage the input buffers of the integer and floating-point high-level APIs. None of this depends on the type
+   of the samples, so the buffers are passed as bytes, along with the size of their samples. 'start' and 'end' are
+   counted in samples from the start of the buffer, and are the bounds of the frames that are left to be resampled. */
+
+#if (!defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_API) && !defined(CLOWNRESAMPLER_RING_BUFFER)) || !defined(CLOWNRESAMPLER_NO_FLOAT_API)
+/* Reads up to 'total_frames' frames to 'buffer', which holds samples of the same type as the input buffer. Returns the
+   number of frames that were read, which is only 0 if the end of the input has been reached. */
+typedef size_t (*ClownResampler_ReadInputFunction)(const void *context, void *buffer, size_t total_frames);
+
+/* Blanks the width of the kernel's left side to zero, since there will not be previous data to occupy it yet. */
+static void ClownResampler_InitInputBuffer(void* const buffer, const size_t sample_size, const size_t radius_in_samples, size_t* const start, size_t* const end)
+{
+	CLOWNRESAMPLER_ZERO(buffer, radius_in_samples * sample_size);
+
+	/* Point to the middle of the first (and newly-initialised) kernel. */
+	*start = *end = radius_in_samples;
+}
+
+/* Makes sure that the input buffer has frames in it, calling 'read' if needed. The integer API manages its buffer
+   itself when it is a ring buffer. Returns 'cc_false' if 'read' ran out of frames. */
+static cc_bool ClownResampler_FillInputBuffer(void* const buffer, const size_t buffer_size, const size_t sample_size, const cc_u8f channels, const size_t radius_in_samples, size_t* const leading_padding_frames_needed, size_t* const start, size_t* const end, const ClownResampler_ReadInputFunction read, const void* const context)
+{
+	unsigned char* const bytes = (unsigned char*)buffer;
+	const size_t double_radius_in_samples = radius_in_samples * 2;
+
+	while (*leading_padding_frames_needed != 0)
+	{
+		const size_t frames_read = read(context, &bytes[(double_radius_in_samples - *leading_padding_frames_needed * channels) * sample_size], *leading_padding_frames_needed);
+
+		if (frames_read == 0)
+			return cc_false;
+
+		*leading_padding_frames_needed -= frames_read;
+	}
+
+	/* If the input buffer is empty, refill it. */
+	if (*start == *end)
+	{
+		/* It is hard to explain this step-by-step, but essentially there is a trick that we do here:
+		   in order to avoid the resampler reading frames outside of the buffer, we have 'deadzones'
+		   at each end of the buffer. When a new batch of frames is needed, the second deadzone is
+		   copied over the first one, and the second is overwritten by the end of the new frames. */
+
+		/* Move the end of the last batch of data to the start of the buffer */
+		/* (memcpy will not work here since the copy may overlap). */
+		CLOWNRESAMPLER_MEMMOVE(bytes, &bytes[(*end - radius_in_samples) * sample_size], double_radius_in_samples * sample_size);
+
+		/* Obtain input frames (note that the new frames start after the frames we just copied). */
+		*start = radius_in_samples;
+		*end = *start + read(context, &bytes[double_radius_in_samples * sample_size], (buffer_size - double_radius_in_samples) / channels) * channels;
+
+		/* If 'read' returns 0, then we must have reached the end of the input data. */
+		if (*start == *end)
+			return cc_false;
+	}
+
+	return cc_true;
+}
+#endif
+
+#if (!defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_API) && !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END)) || !defined(CLOWNRESAMPLER_NO_FLOAT_API)
+/* Writes up to 'total_frames' frames of silence to 'buffer', to pad the end of the input so that the kernel can reach
+   past the last frame. Returns the number of frames that were written. */
+static size_t ClownResampler_ReadPadding(void* const buffer, const size_t frame_size, size_t* const frames_remaining, const size_t total_frames)
+{
+	const size_t frames_to_do = CLOWNRESAMPLER_MIN(total_frames, *frames_remaining);
+
+	CLOWNRESAMPLER_ZERO(buffer, frames_to_do * frame_size);
+
+	*frames_remaining -= frames_to_do;
+
+	return frames_to_do;
+}
+#endif
+
+#endif /* CLOWNRESAMPLER_NO_LOW_LEVEL_API */
+
+#ifndef CLOWNRESAMPLER_NO_HIGH_LEVEL_API
+#define CLOWNRESAMPLER_NO_HIGH_LEVEL_API
+
+/* High-Level API */
+
+/* Returns the factor that the input must be decimated by in order to bring the kernel scale down to
+   'CLOWNRESAMPLER_DECIMATION_THRESHOLD'. Without the CIC filter, this is always a power of two, and without either
+   the CIC filter or the decimation stages, this is always 1. */
+static cc_u32f ClownResampler_HighLevel_PlanDecimation(const cc_u32f input_sample_rate, const cc_u32f actual_low_pass_sample_rate)
+{
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+	const cc_u32f threshold = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(CLOWNRESAMPLER_DECIMATION_THRESHOLD);
+	const cc_u32f kernel_scale = ClownResampler_CalculateRatio(input_sample_rate, actual_low_pass_sample_rate);
+
+	if (actual_low_pass_sample_rate == 0 || kernel_scale <= threshold)
+		return 1;
+
+	/* The sum of 40 cubed s16 samples is the most that fits in 32 bits. */
+	return CLOWNRESAMPLER_MIN(40, kernel_scale / threshold + (kernel_scale % threshold != 0));
+#elif defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+	cc_u8f total_stages = 0;
+
+	/* Multiplying the low-pass filter sample rate cannot overflow, since it remains lower than the input sample rate. */
+	while (total_stages < CLOWNRESAMPLER_MAXIMUM_DECIMATION_STAGES && actual_low_pass_sample_rate != 0 && ClownResampler_CalculateRatio(input_sample_rate, actual_low_pass_sample_rate << total_stages) > CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(CLOWNRESAMPLER_DECIMATION_THRESHOLD))
+		++total_stages;
+
+	return (cc_u32f)1 << total_stages;
+#else
+	(void)input_sample_rate;
+	(void)actual_low_pass_sample_rate;
+
+	return 1;
+#endif
+}
+
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+/* Calculates the coefficient of the [-a, 1 + 2a, -a] filter that undoes the CIC filter's droop at the low-pass
+   filter's cut-off frequency. */
+static cc_s32f ClownResampler_HighLevel_CalculateCICCompensation(const cc_u32f decimation_factor, const cc_u32f input_sample_rate, const cc_u32f actual_low_pass_sample_rate)
+{
+	/* The cut-off frequency is half of the low-pass filter sample rate, as a fraction of the input sample rate, times pi. */
+	const double x = 3.14159265358979323846 * actual_low_pass_sample_rate / 2.0 / input_sample_rate;
+	const double sine = CLOWNRESAMPLER_SIN(x * decimation_factor);
+	const double response = sine / (decimation_factor * CLOWNRESAMPLER_SIN(x));
+
+	/* The compensation filter's response is 1 + 2a(1 - cos(2 * x * factor)), which is 1 + 4a(sin(x * factor) ^ 2). */
+	return (cc_s32f)((1.0 / (response * response * response) - 1.0) / (4.0 * sine * sine) * (1 << 12) + 0.5);
+}
+#endif
+
+/* Returns the buffer that the input frames are stored in. */
+static cc_s16l* ClownResampler_HighLevel_InputBuffer(const ClownResampler_HighLevel_State* const resampler)
+{
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+	if (resampler->input_buffer == NULL)
+		return (cc_s16l*)resampler->default_input_buffer;
+#endif
+
+	return resampler->input_buffer;
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_InitWithBuffer(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate, cc_s16l* const input_buffer, const size_t input_buffer_size)
+{
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(input_sample_rate, CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate));
+	const cc_u32f decimation_factor = ClownResampler_HighLevel_PlanDecimation(input_sample_rate, actual_low_pass_sample_rate);
+
+	size_t usable_input_buffer_size;
+#if !defined(CLOWNRESAMPLER_CIC_DECIMATOR) && defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+	cc_u8f i;
+#endif
+
+	if (channels == 0 || channels > CLOWNRESAMPLER_MAXIMUM_CHANNELS)
+		return cc_false;
+
+	/* The low-level resampler takes its input from the final decimation stage. Rather than dividing the input sample
+	   rate, which would lose precision, the output and low-pass filter sample rates are multiplied instead. */
+	if (output_sample_rate > (cc_u32f)0xFFFFFFFF / decimation_factor)
+		return cc_false;
+
+	if (!ClownResampler_LowLevel_Init(&resampler->low_level, precomputed, channels, input_sample_rate, output_sample_rate * decimation_factor, actual_low_pass_sample_rate * decimation_factor))
+		return cc_false;
+
+	resampler->maximum_integer_stretched_kernel_radius = resampler->leading_padding_frames_needed = resampler->low_level.lowest_level.integer_stretched_kernel_radius;
+	resampler->decimation_factor = decimation_factor;
+
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+	/* The padding is passed through the CIC filter too, so it is measured in its input frames. It must also be long
+	   enough to push the last frames out of the filter, which delays them by less than four of its output frames. */
+	resampler->trailing_padding_frames_remaining = resampler->maximum_integer_stretched_kernel_radius * decimation_factor;
+
+	if (decimation_factor != 1)
+		resampler->trailing_padding_frames_remaining += 4 * decimation_factor;
+
+	/* There are no frames before the first one, so they are silent. */
+	CLOWNRESAMPLER_ZERO(resampler->cic.integrators, sizeof(resampler->cic.integrators));
+	CLOWNRESAMPLER_ZERO(resampler->cic.comb_delays, sizeof(resampler->cic.comb_delays));
+	CLOWNRESAMPLER_ZERO(resampler->cic.compensation_history, sizeof(resampler->cic.compensation_history));
+	resampler->cic.frames_until_output = decimation_factor;
+	resampler->cic.gain = decimation_factor * decimation_factor * decimation_factor;
+	resampler->cic.compensation = decimation_factor == 1 ? 0 : ClownResampler_HighLevel_CalculateCICCompensation(decimation_factor, input_sample_rate, actual_low_pass_sample_rate);
+#elif defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+	/* The padding is passed through the decimation stages too, so it is measured in their input frames. It must also
+	   be long enough to push the last frames out of the stages, each of which holds its filter's radius back. */
+	resampler->trailing_padding_frames_remaining = resampler->maximum_integer_stretched_kernel_radius * decimation_factor + CLOWNRESAMPLER_DECIMATION_STAGE_RADIUS * (decimation_factor - 1);
+
+	resampler->total_decimation_stages = 0;
+
+	while (((cc_u32f)1 << resampler->total_decimation_stages) != decimation_factor)
+		++resampler->total_decimation_stages;
+
+	for (i = 0; i < resampler->total_decimation_stages; ++i)
+	{
+		/* There are no frames before the first one, so they are silent. The first frame to be output is centred on the
+		   first frame to be input, which comes after the history. */
+		CLOWNRESAMPLER_ZERO(resampler->decimation_stages[i].history, sizeof(resampler->decimation_stages[i].history));
+		resampler->decimation_stages[i].next_centre = CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY;
+	}
+#else
+	resampler->trailing_padding_frames_remaining = resampler->maximum_integer_stretched_kernel_radius;
+#endif
+
+	resampler->input_buffer = input_buffer;
+	resampler->input_buffer_size = input_buffer_size;
+
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	/* The ring buffer must hold a whole number of frames. */
+	resampler->ring_buffer_size = usable_input_buffer_size = input_buffer_size / 2 / channels * channels;
+#else
+	usable_input_buffer_size = input_buffer_size;
+#endif
+
+	/* The buffer must have room for the kernel on either side of at least one frame. */
+	if (resampler->maximum_integer_stretched_kernel_radius * 2 >= usable_input_buffer_size / channels)
+		return cc_false;
+
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+
+	/* Blank the width of the kernel's left side to zero, since there will not be previous data to occupy it yet. */
+	CLOWNRESAMPLER_ZERO(input_buffer, resampler->maximum_integer_stretched_kernel_radius * channels * sizeof(*input_buffer));
+	CLOWNRESAMPLER_ZERO(input_buffer + resampler->ring_buffer_size, resampler->maximum_integer_stretched_kernel_radius * channels * sizeof(*input_buffer));
+
+	resampler->ring_buffer_read_index = resampler->ring_buffer_write_index = resampler->maximum_integer_stretched_kernel_radius * channels;
+#else
+	ClownResampler_InitInputBuffer(input_buffer, sizeof(*input_buffer), resampler->maximum_integer_stretched_kernel_radius * channels, &resampler->input_buffer_start, &resampler->input_buffer_end);
+#endif
+
+	return cc_true;
+}
+
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Init(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	if (!ClownResampler_HighLevel_InitWithBuffer(resampler, precomputed, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate, resampler->default_input_buffer, CLOWNRESAMPLER_COUNT_OF(resampler->default_input_buffer)))
+		return cc_false;
+
+	/* The default buffer is found through the state instead of pointed to, so that copies of the state do not use the original's buffer. */
+	resampler->input_buffer = NULL;
+	return cc_true;
+}
+#endif
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+CLOWNRESAMPLER_API void ClownResampler_HighLevel_SetPolyphaseBank(ClownResampler_HighLevel_State* const resampler, ClownResampler_KernelValue* const bank, const size_t bank_length)
+{
+	ClownResampler_LowLevel_SetPolyphaseBank(&resampler->low_level, bank, bank_length);
+}
+#endif
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_GetInputBufferSize(const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate, const size_t total_frames)
+{
+	/* This mirrors the calculation of 'integer_stretched_kernel_radius' in 'ClownResampler_LowestLevel_Configure'. */
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(input_sample_rate, CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate));
+	size_t integer_stretched_kernel_radius, total_buffer_frames;
+	cc_u32f kernel_scale;
+
+	if (channels == 0 || actual_low_pass_sample_rate == 0)
+		return 0;
+
+	kernel_scale = ClownResampler_CalculateRatio(input_sample_rate, actual_low_pass_sample_rate * ClownResampler_HighLevel_PlanDecimation(input_sample_rate, actual_low_pass_sample_rate));
+
+	if (precomputed->kernel_radius > (size_t)-1 / kernel_scale || (size_t)precomputed->kernel_radius * kernel_scale > CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)CLOWNRESAMPLER_MAXIMUM_STRETCHED_KERNEL_RADIUS))
+		return 0;
+
+	integer_stretched_kernel_radius = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(precomputed->kernel_radius * kernel_scale);
+
+	/* A frame to resample, with the kernel's radius on either side. */
+	total_buffer_frames = CLOWNRESAMPLER_MAX(total_frames, 1) + integer_stretched_kernel_radius * 2;
+
+	if (total_buffer_frames < integer_stretched_kernel_radius * 2 || total_buffer_frames > (size_t)-1 / 2 / channels)
+		return 0;
+
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	/* The ring buffer is mirrored, so it needs twice the space. */
+	return total_buffer_frames * channels * 2;
+#else
+	return total_buffer_frames * channels;
+#endif
+}
+
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+/* Mirrors the samples that the input callback has just written at the write index, and then advances the write index past them. */
+static void ClownResampler_HighLevel_CommitInput(ClownResampler_HighLevel_State* const resampler, const size_t total_samples)
+{
+	const size_t ring_buffer_size = resampler->ring_buffer_size;
+	const size_t write_index = resampler->ring_buffer_write_index;
+	const size_t samples_before_mirror = CLOWNRESAMPLER_MIN(total_samples, ring_buffer_size - write_index);
+	cc_s16l* const input_buffer = ClownResampler_HighLevel_InputBuffer(resampler);
+
+	/* The callback is allowed to write past the end of the ring buffer and into its mirror, so copy in both directions. */
+	CLOWNRESAMPLER_MEMCPY(&input_buffer[write_index + ring_buffer_size], &input_buffer[write_index], samples_before_mirror * sizeof(*input_buffer));
+	CLOWNRESAMPLER_MEMCPY(input_buffer, &input_buffer[ring_buffer_size], (total_samples - samples_before_mirror) * sizeof(*input_buffer));
+
+	resampler->ring_buffer_write_index = (write_index + total_samples) % ring_buffer_size;
+}
+
+/* Returns the number of samples that can be resampled before more input is needed. */
+static size_t ClownResampler_HighLevel_InputSamplesAvailable(const ClownResampler_HighLevel_State* const resampler)
+{
+	/* The frames within the kernel's radius after the last frame have to be read too, so they do not count. */
+	return (resampler->ring_buffer_write_index + resampler->ring_buffer_size - resampler->ring_buffer_read_index) % resampler->ring_buffer_size - resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels;
+}
+#endif
+
+/* Produces the input buffer that is to be passed to the low-level API, as well as its size in frames. */
+static const cc_s16l* ClownResampler_HighLevel_GetInput(const ClownResampler_HighLevel_State* const resampler, size_t* const total_input_frames)
+{
+	const size_t radius_in_samples = resampler->low_level.lowest_level.integer_stretched_kernel_radius * resampler->low_level.channels;
+
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	/* Thanks to the mirror, the frames can be read contiguously starting from anywhere in the ring buffer. */
+	*total_input_frames = ClownResampler_HighLevel_InputSamplesAvailable(resampler) / resampler->low_level.channels;
+	return &ClownResampler_HighLevel_InputBuffer(resampler)[(resampler->ring_buffer_read_index + resampler->ring_buffer_size - radius_in_samples) % resampler->ring_buffer_size];
+#else
+	*total_input_frames = (resampler->input_buffer_end - resampler->input_buffer_start) / resampler->low_level.channels;
+	return &ClownResampler_HighLevel_InputBuffer(resampler)[resampler->input_buffer_start - radius_in_samples];
+#endif
+}
+
+/* Discards the frames that the low-level API has finished with. */
+static void ClownResampler_HighLevel_DiscardInput(ClownResampler_HighLevel_State* const resampler, const size_t input_frames_remaining)
+{
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	resampler->ring_buffer_read_index = (resampler->ring_buffer_write_index + resampler->ring_buffer_size - (resampler->maximum_integer_stretched_kernel_radius + input_frames_remaining) * resampler->low_level.channels) % resampler->ring_buffer_size;
+#else
+	resampler->input_buffer_start = resampler->input_buffer_end - input_frames_remaining * resampler->low_level.channels;
+#endif
+}
+
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+/* Passes frames through the CIC filter and the filter that compensates for its droop. Like the 2:1 decimation stages,
+   this is done in-place. Returns the number of frames that came out of the filter. */
+static size_t ClownResampler_HighLevel_DecimateCIC(ClownResampler_HighLevel_State* const resampler, cc_s16l* const buffer, const size_t total_frames)
+{
+	const cc_u8f channels = resampler->low_level.channels;
+	const cc_u32f decimation_factor = resampler->decimation_factor;
+	const cc_s32f gain = (cc_s32f)resampler->cic.gain;
+	const cc_s32f compensation = resampler->cic.compensation;
+
+	size_t frames_out = 0;
+	cc_u8f current_channel;
+
+	/* Each channel is filtered separately, so that the filter's state can be kept in local variables. This is still
+	   safe to do in-place, since a channel's output frames only overwrite that channel's input frames. */
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+	{
+		cc_u32f* const integrators = &resampler->cic.integrators[current_channel * 3];
+		cc_u32f* const comb_delays = &resampler->cic.comb_delays[current_channel * 3];
+		cc_s16l* const history = &resampler->cic.compensation_history[current_channel * 2];
+
+		cc_u32f integrator_1 = integrators[0], integrator_2 = integrators[1], integrator_3 = integrators[2];
+		cc_u32f frames_until_output = resampler->cic.frames_until_output;
+		const cc_s16l *input_sample = &buffer[current_channel];
+		const cc_s16l* const input_end = input_sample + total_frames * channels;
+		cc_s16l *output_sample = &buffer[current_channel];
+
+		while (input_sample != input_end)
+		{
+			/* The integrators run at the input sample rate. Their sums overflow, but this is cancelled out by the combs. */
+			const size_t frames = CLOWNRESAMPLER_MIN(frames_until_output, (size_t)(input_end - input_sample) / channels);
+			const cc_s16l* const batch_end = input_sample + frames * channels;
+
+			for (; input_sample != batch_end; input_sample += channels)
+			{
+				integrator_1 += (cc_u32f)*input_sample;
+				integrator_2 += integrator_1;
+				integrator_3 += integrator_2;
+			}
+
+			frames_until_output -= frames;
+
+			if (frames_until_output == 0)
+			{
+				/* The combs run at the output sample rate. */
+				cc_u32f value = integrator_3;
+				cc_u8f i;
+				cc_s32f sample, difference;
+
+				frames_until_output = decimation_factor;
+
+				for (i = 0; i < 3; ++i)
+				{
+					const cc_u32f delayed_value = comb_delays[i];
+
+					comb_delays[i] = value;
+					value -= delayed_value;
+				}
+
+				/* Convert from the wrapped-around unsigned sum to a signed one, and undo the filter's gain. */
+				value &= 0xFFFFFFFF;
+				sample = (value & 0x80000000) != 0 ? -(cc_s32f)(0xFFFFFFFF - value) - 1 : (cc_s32f)value;
+				sample /= gain;
+
+				/* Apply the compensation filter, which delays the output by a frame. */
+				difference = (cc_s32f)history[1] * 2 - history[0] - sample;
+				history[0] = history[1];
+				history[1] = (cc_s16l)sample;
+				sample = history[0] + difference * compensation / (1 << 12);
+
+				*output_sample = (cc_s16l)CLOWNRESAMPLER_CLAMP(-0x7FFF - 1, 0x7FFF, sample);
+				output_sample += channels;
+			}
+		}
+
+		integrators[0] = integrator_1;
+		integrators[1] = integrator_2;
+		integrators[2] = integrator_3;
+
+		/* Every channel ends in the same place. */
+		if (current_channel == channels - 1)
+		{
+			resampler->cic.frames_until_output = frames_until_output;
+			frames_out = (size_t)(output_sample - &buffer[current_channel]) / channels;
+		}
+	}
+
+	return frames_out;
+}
+#elif defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+/* Passes frames through a 2:1 decimation stage, which applies a half-band low-pass filter and then discards every other
+   frame. This is done in-place, which works because the frames that come out are never ahead of the frames that go in.
+   Returns the number of frames that came out of the stage. */
+static size_t ClownResampler_HighLevel_Decimate(ClownResampler_HighLevel_State* const resampler, const cc_u8f stage_index, cc_s16l* const buffer, const size_t total_frames)
+{
+	/* The odd taps of the half-band filter, from the centre outwards, out of 4096. The centre tap is 2048, and the even
+	   taps are 0. This is the maximally-flat half-band filter with eight zeros at the Nyquist frequency: it takes less
+	   than 0.001dB from the passband of the Lanczos kernel, and attenuates everything that would alias into that
+	   passband by more than 80dB. */
+	static const cc_s16l taps[(CLOWNRESAMPLER_DECIMATION_STAGE_RADIUS + 1) / 2] = {1225, -245, 49, -5};
+
+	const cc_u8f channels = resampler->low_level.channels;
+
+	cc_s16l* const history = resampler->decimation_stages[stage_index].history;
+	size_t frames_in = 0, frames_out = 0;
+	size_t centre = resampler->decimation_stages[stage_index].next_centre;
+
+	/* The frames are copied to a window along with the stage's history, so that the frames that come out do not
+	   overwrite the frames that are still needed. */
+	while (frames_in != total_frames)
+	{
+		const size_t frames = CLOWNRESAMPLER_MIN(0x40, total_frames - frames_in);
+
+		cc_s16l window[(CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY + 0x40) * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+		CLOWNRESAMPLER_MEMCPY(window, history, CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY * channels * sizeof(*window));
+		CLOWNRESAMPLER_MEMCPY(&window[CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY * channels], &buffer[frames_in * channels], frames * channels * sizeof(*window));
+
+		for (; centre + CLOWNRESAMPLER_DECIMATION_STAGE_RADIUS < CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY + frames; centre += 2)
+		{
+			const cc_s16l* const samples = &window[centre * channels];
+
+			cc_u8f current_channel;
+
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+			{
+				cc_s32f sum, sample;
+				cc_u8f tap;
+
+				/* Every other tap except the centre one is 0, so those taps do not need to be read. */
+				sum = (cc_s32f)samples[current_channel] * 2048;
+
+				for (tap = 0; tap < CLOWNRESAMPLER_COUNT_OF(taps); ++tap)
+				{
+					const cc_s16l* const before = samples - (tap * 2 + 1) * channels;
+					const cc_s16l* const after = samples + (tap * 2 + 1) * channels;
+
+					sum += ((cc_s32f)before[current_channel] + after[current_channel]) * taps[tap];
+				}
+
+				/* Round to the nearest integer. Rounding towards zero, as the division does, would make the error
+				   follow the sign of the signal, which adds up to audible odd harmonics over several stages. */
+				sample = (sum + (sum < 0 ? -2048 : 2048)) / 4096;
+
+				buffer[frames_out * channels + current_channel] = (cc_s16l)CLOWNRESAMPLER_CLAMP(-0x7FFF - 1, 0x7FFF, sample);
+			}
+
+			++frames_out;
+		}
+
+		/* The last frames become the history of the next window. */
+		CLOWNRESAMPLER_MEMCPY(history, &window[frames * channels], CLOWNRESAMPLER_DECIMATION_STAGE_HISTORY * channels * sizeof(*window));
+		centre -= frames;
+		frames_in += frames;
+	}
+
+	resampler->decimation_stages[stage_index].next_centre = (cc_u8f)centre;
+
+	return frames_out;
+}
+#endif
+
+/* Calls the input callback, and passes the frames that it produces through the decimation stages.
+   Returns the number of frames that came out of the final stage, which is only 0 if the input callback returned 0. */
+static size_t ClownResampler_HighLevel_ReadInput(ClownResampler_HighLevel_State* const resampler, const ClownResampler_InputCallback input_callback, const void* const user_data, cc_s16l* const buffer, const size_t total_frames)
+{
+	size_t frames_done = 0;
+
+	/* A frame only comes out of the stages for every few that go in, so keep going until one does. */
+	while (frames_done == 0)
+	{
+	#if !defined(CLOWNRESAMPLER_CIC_DECIMATOR) && defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+		cc_u8f i;
+	#endif
+
+		frames_done = input_callback((void*)user_data, buffer, total_frames);
+
+		if (frames_done == 0)
+			break;
+
+	#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+		if (resampler->decimation_factor != 1)
+			frames_done = ClownResampler_HighLevel_DecimateCIC(resampler, buffer, frames_done);
+	#elif defined(CLOWNRESAMPLER_DECIMATION_STAGES)
+		for (i = 0; i < resampler->total_decimation_stages; ++i)
+			frames_done = ClownResampler_HighLevel_Decimate(resampler, i, buffer, frames_done);
+	#else
+		(void)resampler;
+	#endif
+	}
+
+	return frames_done;
+}
+
+#ifndef CLOWNRESAMPLER_RING_BUFFER
+typedef struct ClownResampler_HighLevel_ReadInputContext
+{
+	ClownResampler_HighLevel_State *resampler;
+	ClownResampler_InputCallback input_callback;
+	const void *user_data;
+} ClownResampler_HighLevel_ReadInputContext;
+
+/* 'ClownResampler_HighLevel_ReadInput', in the form that 'ClownResampler_FillInputBuffer' takes. */
+static size_t ClownResampler_HighLevel_ReadInputWithContext(const void* const context, void* const buffer, const size_t total_frames)
+{
+	const ClownResampler_HighLevel_ReadInputContext* const data = (const ClownResampler_HighLevel_ReadInputContext*)context;
+
+	return ClownResampler_HighLevel_ReadInput(data->resampler, data->input_callback, data->user_data, (cc_s16l*)buffer, total_frames);
+}
+#endif
+
+/* Makes sure that the input buffer has frames in it, calling the input callback if needed.
+   Returns 'cc_false' if the input callback ran out of frames. */
+static cc_bool ClownResampler_HighLevel_FillInputBuffer(ClownResampler_HighLevel_State* const resampler, const ClownResampler_InputCallback input_callback, const void* const user_data)
+{
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	const size_t maximum_radius_in_samples = resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels;
+
+	while (resampler->leading_padding_frames_needed != 0)
+	{
+		const size_t frames_read = ClownResampler_HighLevel_ReadInput(resampler, input_callback, user_data, &ClownResampler_HighLevel_InputBuffer(resampler)[resampler->ring_buffer_write_index], resampler->leading_padding_frames_needed);
+
+		if (frames_read == 0)
+			return cc_false;
+
+		ClownResampler_HighLevel_CommitInput(resampler, frames_read * resampler->low_level.channels);
+		resampler->leading_padding_frames_needed -= frames_read;
+	}
+
+	/* If the input buffer is empty, refill it. */
+	if (ClownResampler_HighLevel_InputSamplesAvailable(resampler) == 0)
+	{
+		/* Everything except for the frames within the kernel's radius of the current frame is free to be overwritten.
+		   Unlike the regular buffer, these frames do not need to be moved out of the way first. */
+		const size_t frames_read = ClownResampler_HighLevel_ReadInput(resampler, input_callback, user_data, &ClownResampler_HighLevel_InputBuffer(resampler)[resampler->ring_buffer_write_index], (resampler->ring_buffer_size - maximum_radius_in_samples * 2) / resampler->low_level.channels);
+
+		/* If the callback returns 0, then we must have reached the end of the input data. */
+		if (frames_read == 0)
+			return cc_false;
+
+		ClownResampler_HighLevel_CommitInput(resampler, frames_read * resampler->low_level.channels);
+	}
+
+	return cc_true;
+#else
+	ClownResampler_HighLevel_ReadInputContext context;
+	context.resampler = resampler;
+	context.input_callback = input_callback;
+	context.user_data = user_data;
+
+	return ClownResampler_FillInputBuffer(ClownResampler_HighLevel_InputBuffer(resampler), resampler->input_buffer_size, sizeof(*resampler->input_buffer), resampler->low_level.channels, resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels, &resampler->leading_padding_frames_needed, &resampler->input_buffer_start, &resampler->input_buffer_end, ClownResampler_HighLevel_ReadInputWithContext, &context);
+#endif
+}
+
+/* Only one of 's32_output_buffer' and 's16_output_buffer' should be non-NULL. */
+static size_t ClownResampler_HighLevel_ResampleToBuffer(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, cc_s32f* const s32_output_buffer, cc_s16l* const s16_output_buffer, const cc_bool mix, const cc_u32f gain, const size_t total_output_frames, const void* const user_data)
+{
+	size_t frames_done = 0;
+
+	while (frames_done < total_output_frames && ClownResampler_HighLevel_FillInputBuffer(resampler, input_callback, user_data))
+	{
+		const size_t output_offset = frames_done * resampler->low_level.channels;
+
+		size_t input_frames;
+		const cc_s16l* const input_buffer = ClownResampler_HighLevel_GetInput(resampler, &input_frames);
+
+		frames_done += ClownResampler_LowLevel_ResampleToBuffer(&resampler->low_level, precomputed, input_buffer, &input_frames, s32_output_buffer == NULL ? NULL : &s32_output_buffer[output_offset], s16_output_buffer == NULL ? NULL : &s16_output_buffer[output_offset], mix, gain, total_output_frames - frames_done);
+
+		/* Increment input pointer. */
+		ClownResampler_HighLevel_DiscardInput(resampler, input_frames);
+	}
+
+	return frames_done;
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Resample(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+{
+	cc_bool reached_end_of_output_buffer = cc_false;
+
+	do
+	{
+		/* If the callback returns 0, then we must have reached the end of the input data, so quit. */
+		if (!ClownResampler_HighLevel_FillInputBuffer(resampler, input_callback, user_data))
+			return cc_true;
+
+		/* Call the actual resampler. */
+		{
+			size_t input_frames;
+			const cc_s16l* const input_buffer = ClownResampler_HighLevel_GetInput(resampler, &input_frames);
+
+			reached_end_of_output_buffer = ClownResampler_LowLevel_Resample(&resampler->low_level, precomputed, input_buffer, &input_frames, output_callback, user_data) == 0;
+
+			/* Increment input and output pointers. */
+			ClownResampler_HighLevel_DiscardInput(resampler, input_frames);
+		}
+	} while (!reached_end_of_output_buffer);
+
+	return cc_false;
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleToS32(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, cc_s32f* const output_buffer, const size_t total_output_frames, const void* const user_data)
+{
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, input_callback, output_buffer, NULL, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames, user_data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleToS16(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, cc_s16l* const output_buffer, const size_t total_output_frames, const void* const user_data)
+{
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, input_callback, NULL, output_buffer, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames, user_data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_MixToS32(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, cc_s32f* const output_buffer, const size_t total_output_frames, const cc_u32f gain, const void* const user_data)
+{
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, input_callback, output_buffer, NULL, cc_true, gain, total_output_frames, user_data);
+}
+
+#ifndef CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST
+#define CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Adjust(ClownResampler_HighLevel_State* const resampler, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	const cc_u32f decimation_factor = resampler->decimation_factor;
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(input_sample_rate, CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate));
+
+	/* The new configuration is checked before the resampler is adjusted, so that the resampler is left as it was if it
+	   fails. This configuration has no filter-bank, so making it does not touch the resampler's. */
+	ClownResampler_LowestLevel_Configuration configuration;
+
+	/* As in 'ClownResampler_HighLevel_InitWithBuffer', the rates are adjusted to suit the final decimation stage. */
+	if (output_sample_rate > (cc_u32f)0xFFFFFFFF / decimation_factor)
+		return cc_false;
+
+	if (!ClownResampler_LowestLevel_Configure(&configuration, resampler->low_level.lowest_level.kernel_radius, resampler->low_level.lowest_level.kernel_resolution, input_sample_rate, output_sample_rate * decimation_factor, actual_low_pass_sample_rate * decimation_factor))
+		return cc_false;
+
+	/* Fail if the ratio is too large. See the warning in this function's documentation for more information. */
+	if (configuration.integer_stretched_kernel_radius > resampler->maximum_integer_stretched_kernel_radius)
+		return cc_false;
+
+	/* Freak-out if the ratio is so high that the kernel radius would exceed the size of the input buffer. */
+#ifdef CLOWNRESAMPLER_RING_BUFFER
+	if (configuration.integer_stretched_kernel_radius * 2 >= resampler->ring_buffer_size / resampler->low_level.channels)
+#else
+	if (configuration.integer_stretched_kernel_radius * 2 >= resampler->input_buffer_size / resampler->low_level.channels)
+#endif
+		return cc_false;
+
+	if (!ClownResampler_LowLevel_Adjust(&resampler->low_level, input_sample_rate, output_sample_rate * decimation_factor, actual_low_pass_sample_rate * decimation_factor))
+		return cc_false;
+
+#ifdef CLOWNRESAMPLER_CIC_DECIMATOR
+	/* The droop that the compensation filter undoes depends on where the low-pass filter's cut-off is. */
+	if (decimation_factor != 1)
+		resampler->cic.compensation = ClownResampler_HighLevel_CalculateCICCompensation(decimation_factor, input_sample_rate, actual_low_pass_sample_rate);
+#endif
+
+	return cc_true;
+}
+
+#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST */
+
+#ifndef CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END
+#define CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END
+
+typedef struct ClownResampler_CallbackWrapperData
+{
+	ClownResampler_HighLevel_State *resampler;
+	ClownResampler_OutputCallback output_callback;
+	void *user_data;
+} ClownResampler_CallbackWrapperData;
+
+static size_t ClownResampler_PaddingCallback(void* const user_data, cc_s16l* const buffer, const size_t total_frames)
+{
+	const ClownResampler_CallbackWrapperData* const data = (ClownResampler_CallbackWrapperData*)user_data;
+
+	return ClownResampler_ReadPadding(buffer, data->resampler->low_level.channels * sizeof(*buffer), &data->resampler->trailing_padding_frames_remaining, total_frames);
+}
+
+static cc_bool ClownResampler_OutputCallbackWrapper(void* const user_data, const cc_s32f* const frame, const cc_u8f total_samples)
+{
+	const ClownResampler_CallbackWrapperData* const data = (ClownResampler_CallbackWrapperData*)user_data;
+
+	return data->output_callback(data->user_data, frame, total_samples);
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_ResampleEnd(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+{
+	ClownResampler_CallbackWrapperData data;
+	data.resampler = resampler;
+	data.output_callback = output_callback;
+	data.user_data = (void*)user_data;
+
+	return ClownResampler_HighLevel_Resample(resampler, precomputed, ClownResampler_PaddingCallback, ClownResampler_OutputCallbackWrapper, &data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleEndToS32(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_buffer, const size_t total_output_frames)
+{
+	ClownResampler_CallbackWrapperData data;
+	data.resampler = resampler;
+	data.output_callback = NULL;
+	data.user_data = NULL;
+
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, ClownResampler_PaddingCallback, output_buffer, NULL, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames, &data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_ResampleEndToS16(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, cc_s16l* const output_buffer, const size_t total_output_frames)
+{
+	ClownResampler_CallbackWrapperData data;
+	data.resampler = resampler;
+	data.output_callback = NULL;
+	data.user_data = NULL;
+
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, ClownResampler_PaddingCallback, NULL, output_buffer, cc_false, CLOWNRESAMPLER_GAIN_UNITY, total_output_frames, &data);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevel_MixEndToS32(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, cc_s32f* const output_buffer, const size_t total_output_frames, const cc_u32f gain)
+{
+	ClownResampler_CallbackWrapperData data;
+	data.resampler = resampler;
+	data.output_callback = NULL;
+	data.user_data = NULL;
+
+	return ClownResampler_HighLevel_ResampleToBuffer(resampler, precomputed, ClownResampler_PaddingCallback, output_buffer, NULL, cc_true, gain, total_output_frames, &data);
+}
+
+#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END */
+
+#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_API */
+
+#ifndef CLOWNRESAMPLER_NO_STEP_API
+#define CLOWNRESAMPLER_NO_STEP_API
+
+/* Band-Limited Step API */
+
+/* Advances a position by 'clocks', which is multiplied by the 0.32 'frames_per_clock'. The multiplication is done in
+   16-bit pieces, since C89 does not guarantee a 64-bit integer type (unlike 'CLOWNRESAMPLER_WIDE_ACCUMULATOR', this is
+   always compiled, so it cannot rely on one). */
+static void ClownResampler_Step_Advance(size_t* const position_integer, cc_u32f* const position_fractional, const cc_u32f clocks, const cc_u32f frames_per_clock)
+{
+	const cc_u32f clocks_upper = (clocks >> 16) & 0xFFFF, clocks_lower = clocks & 0xFFFF;
+	const cc_u32f frames_upper = frames_per_clock >> 16, frames_lower = frames_per_clock & 0xFFFF;
+	const cc_u32f upper = clocks_upper * frames_upper;
+	const cc_u32f middle_1 = clocks_upper * frames_lower;
+	const cc_u32f middle_2 = clocks_lower * frames_upper;
+	const cc_u32f lower = clocks_lower * frames_lower;
+	const cc_u32f fraction_lower = (lower & 0xFFFF) + (*position_fractional & 0xFFFF);
+	const cc_u32f fraction_upper = (lower >> 16) + (middle_1 & 0xFFFF) + (middle_2 & 0xFFFF) + (*position_fractional >> 16) + (fraction_lower >> 16);
+
+	*position_fractional = ((fraction_upper & 0xFFFF) << 16) | (fraction_lower & 0xFFFF);
+	*position_integer += upper + (middle_1 >> 16) + (middle_2 >> 16) + (fraction_upper >> 16);
+}
+
+/* Returns the kernel table entry that is 'distance' entries from the centre of the kernel, in the table's fixed-point format. */
+static cc_s32f ClownResampler_Step_GetKernelValue(const ClownResampler_Precomputed* const precomputed, const double distance)
+{
+	const size_t index = (size_t)(CLOWNRESAMPLER_FABS(distance) + 0.5);
+	const size_t half_length = (size_t)precomputed->kernel_radius * precomputed->kernel_resolution;
+
+	if (index >= half_length)
+		return 0;
+
+#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+	return precomputed->lanczos_kernel_table[index];
+#else
+	return precomputed->lanczos_kernel_table[half_length + index];
+#endif
+}
+
+static void ClownResampler_Step_ConfigureBank(ClownResampler_Step_State* const step, const ClownResampler_Precomputed* const precomputed, const double kernel_entries_per_frame)
+{
+	cc_u32f phase;
+
+	for (phase = 0; phase < CLOWNRESAMPLER_STEP_PHASES; ++phase)
 	{
-		/* Check if we have reached the end of the input buffer. */
-		if (resampler->position_integer >= *total_input_frames)
+		cc_s32l* const coefficients = &step->bank[phase * step->total_taps];
+		/* Each phase is centred in the range of positions that are rounded to it. */
+		const double first_edge = -(double)step->integer_stretched_kernel_radius - ((double)phase + 0.5) / CLOWNRESAMPLER_STEP_PHASES;
+
+		double areas[CLOWNRESAMPLER_STEP_MAXIMUM_COEFFICIENTS / CLOWNRESAMPLER_STEP_PHASES];
+		double sum;
+		cc_s32f total;
+		size_t tap, largest_tap;
+
+		/* A band-limited step is the integral of the kernel, and so the amount that it rises over the course of each
+		   frame is the area of the kernel within that frame. This is found by summing the kernel table's entries. */
+		sum = 0.0;
+
+		for (tap = 0; tap < step->total_taps; ++tap)
 		{
-			resampler->position_integer -= *total_input_frames;
-			*total_input_frames = 0;
-			return cc_true;
+			const double start = ((double)tap + first_edge) * kernel_entries_per_frame;
+			const double end = start + kernel_entries_per_frame;
+
+			double entry;
+
+			areas[tap] = 0.0;
+
+			for (entry = start + 0.5; entry < end; entry += 1.0)
+				areas[tap] += ClownResampler_Step_GetKernelValue(precomputed, entry);
+
+			sum += areas[tap];
 		}
-		else
-		{
-			cc_s32f samples[CLOWNRESAMPLER_MAXIMUM_CHANNELS] = {0}; /* Sample accumulators. */
 
-			ClownResampler_LowestLevel_Resample(&resampler->lowest_level, precomputed, samples, resampler->channels, input_buffer, resampler->position_integer, resampler->position_fractional);
+		/* Normalise the areas so that the whole step rises by exactly 1, even after rounding. */
+		total = 0;
+		largest_tap = 0;
 
-			/* Increment input buffer position. */
-			resampler->position_fractional += resampler->increment;
-			resampler->position_integer += CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(resampler->position_fractional);
-			resampler->position_fractional %= CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE;
+		for (tap = 0; tap < step->total_taps; ++tap)
+		{
+			const double coefficient = areas[tap] / sum * (1 << 15);
 
-			/* Output the samples. */
-			if (!output_callback((void*)user_data, samples, resampler->channels))
-			{
-				/* We've reached the end of the output buffer. */
-				const size_t delta = CLOWNRESAMPLER_MIN(resampler->position_integer, *total_input_frames);
+			coefficients[tap] = (cc_s32l)(coefficient < 0.0 ? coefficient - 0.5 : coefficient + 0.5);
+			total += coefficients[tap];
 
-				*total_input_frames -= delta;
-				resampler->position_integer -= delta;
-				return cc_false;
-			}
+			if (coefficients[tap] > coefficients[largest_tap])
+				largest_tap = tap;
 		}
+
+		coefficients[largest_tap] += (1 << 15) - total;
 	}
 }
 
-#endif /* CLOWNRESAMPLER_NO_LOW_LEVEL_API */
-
-#ifndef CLOWNRESAMPLER_NO_HIGH_LEVEL_API
-#define CLOWNRESAMPLER_NO_HIGH_LEVEL_API
+CLOWNRESAMPLER_API cc_bool ClownResampler_Step_Init(ClownResampler_Step_State* const step, const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f clock_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate, cc_s32f* const buffer, const size_t buffer_size)
+{
+	/* Unlike with the resamplers, the kernel is stretched relative to the output sample rate, since the steps are
+	   rendered directly at that rate. */
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate);
+	const cc_u32f kernel_scale = ClownResampler_CalculateRatio(output_sample_rate, actual_low_pass_sample_rate);
 
-/* High-Level API */
+	if (channels == 0 || channels > CLOWNRESAMPLER_MAXIMUM_CHANNELS || output_sample_rate == 0 || output_sample_rate >= clock_rate)
+		return cc_false;
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Init(ClownResampler_HighLevel_State* const resampler, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
-{
-	if (channels > CLOWNRESAMPLER_MAXIMUM_CHANNELS)
+	/* Bail on crazy ratios. Kernels this wide would not fit in the bank anyway. */
+	if (actual_low_pass_sample_rate == 0 || kernel_scale >= CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(0x1000) || precomputed->kernel_radius > (size_t)-1 / kernel_scale)
 		return cc_false;
 
-	if (!ClownResampler_LowLevel_Init(&resampler->low_level, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate))
+	step->channels = channels;
+	step->frames_per_clock = ClownResampler_CalculateFraction(output_sample_rate, clock_rate);
+	step->integer_stretched_kernel_radius = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(precomputed->kernel_radius * kernel_scale);
+	/* A step that lies between two frames has part of the kernel's edge in an extra frame. */
+	step->total_taps = step->integer_stretched_kernel_radius * 2 + 1;
+	step->position_integer = 0;
+	step->position_fractional = 0;
+	step->buffer = buffer;
+	step->buffer_frames = buffer_size / channels;
+	CLOWNRESAMPLER_ZERO(step->levels, sizeof(step->levels));
+
+	if (step->total_taps > CLOWNRESAMPLER_COUNT_OF(step->bank) / CLOWNRESAMPLER_STEP_PHASES)
 		return cc_false;
 
-	resampler->maximum_integer_stretched_kernel_radius = resampler->leading_padding_frames_needed = resampler->trailing_padding_frames_remaining = resampler->low_level.lowest_level.integer_stretched_kernel_radius;
+	/* The buffer must have room for every frame that a step can affect, plus the frame that the step is in. */
+	if (step->buffer_frames <= step->total_taps + 1)
+		return cc_false;
 
-	/* Blank the width of the kernel's left side to zero, since there will not be previous data to occupy it yet. */
-	CLOWNRESAMPLER_ZERO(resampler->input_buffer, resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels * sizeof(*resampler->input_buffer));
+	ClownResampler_Step_ConfigureBank(step, precomputed, (double)precomputed->kernel_resolution * actual_low_pass_sample_rate / output_sample_rate);
 
-	/* Initialise the pointers to point to the middle of the first (and newly-initialised) kernel. */
-	resampler->input_buffer_start = resampler->input_buffer_end = resampler->input_buffer + resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels;
+	CLOWNRESAMPLER_ZERO(buffer, step->buffer_frames * channels * sizeof(*buffer));
 
 	return cc_true;
 }
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Resample(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_InputCallback input_callback, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+CLOWNRESAMPLER_API size_t ClownResampler_Step_GetBufferSize(const ClownResampler_Precomputed* const precomputed, const cc_u8f channels, const cc_u32f clock_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate, const size_t total_frames)
 {
-	cc_bool reached_end_of_output_buffer = cc_false;
+	/* This mirrors the calculation of 'total_taps' in 'ClownResampler_Step_Init'. */
+	const cc_u32f actual_low_pass_sample_rate = CLOWNRESAMPLER_MIN(output_sample_rate, low_pass_filter_sample_rate);
+	const cc_u32f kernel_scale = ClownResampler_CalculateRatio(output_sample_rate, actual_low_pass_sample_rate);
 
-	const size_t maximum_radius_in_samples = resampler->maximum_integer_stretched_kernel_radius * resampler->low_level.channels;
-	const size_t double_maximum_radius_in_samples = maximum_radius_in_samples * 2;
+	size_t total_buffer_frames;
 
-	while (resampler->leading_padding_frames_needed != 0)
+	if (channels == 0 || output_sample_rate >= clock_rate || actual_low_pass_sample_rate == 0)
+		return 0;
+
+	if (kernel_scale >= CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(0x1000) || precomputed->kernel_radius > (size_t)-1 / kernel_scale)
+		return 0;
+
+	total_buffer_frames = total_frames + CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(precomputed->kernel_radius * kernel_scale) * 2 + 2;
+
+	if (total_buffer_frames < total_frames || total_buffer_frames > (size_t)-1 / channels)
+		return 0;
+
+	return total_buffer_frames * channels;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_Step_AddDelta(ClownResampler_Step_State* const step, const cc_u32f clock, const cc_u8f channel, const cc_s32f delta)
+{
+	size_t position_integer = step->position_integer;
+	cc_u32f position_fractional = step->position_fractional;
+	const cc_s32l *coefficients;
+	cc_s32f *sample, *largest_sample;
+	cc_s32f remaining_delta, largest_coefficient;
+	size_t i;
+
+	CLOWNRESAMPLER_ASSERT(channel < step->channels);
+	CLOWNRESAMPLER_ASSERT(delta >= -0xFFFF && delta <= 0xFFFF);
+
+	ClownResampler_Step_Advance(&position_integer, &position_fractional, clock, step->frames_per_clock);
+
+	/* The step is centred 'integer_stretched_kernel_radius' frames after its position, so that its first tap lands on
+	   the frame after it. This way, it never affects a frame that may have been read already. */
+	CLOWNRESAMPLER_ASSERT(position_integer + step->total_taps < step->buffer_frames);
+
+	coefficients = &step->bank[(size_t)(position_fractional / (0xFFFFFFFF / CLOWNRESAMPLER_STEP_PHASES + 1)) * step->total_taps];
+	sample = &step->buffer[(position_integer + 1) * step->channels + channel];
+	largest_sample = sample;
+	largest_coefficient = 0;
+	remaining_delta = delta;
+
+	for (i = 0; i < step->total_taps; ++i)
 	{
-		cc_s16l* const buffer = &resampler->input_buffer[double_maximum_radius_in_samples - resampler->leading_padding_frames_needed * resampler->low_level.channels];
-		const size_t frames_read = input_callback((void*)user_data, buffer, resampler->leading_padding_frames_needed);
+		const cc_s32f value = coefficients[i] * delta / (1 << 15);
 
-		if (frames_read == 0)
-			return cc_true;
+		*sample += value;
+		remaining_delta -= value;
 
-		resampler->leading_padding_frames_needed -= frames_read;
+		if (coefficients[i] > largest_coefficient)
+		{
+			largest_coefficient = coefficients[i];
+			largest_sample = sample;
+		}
+
+		sample += step->channels;
 	}
 
-	do
+	/* Whatever was lost to rounding goes to the largest tap, so that the taps add up to exactly 'delta'. */
+	*largest_sample += remaining_delta;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_Step_EndFrame(ClownResampler_Step_State* const step, const cc_u32f total_clocks)
+{
+	ClownResampler_Step_Advance(&step->position_integer, &step->position_fractional, total_clocks, step->frames_per_clock);
+
+	/* If this fails, then frames need to be read more often, or the buffer needs to be larger. */
+	CLOWNRESAMPLER_ASSERT(step->position_integer + step->total_taps < step->buffer_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_Step_GetAvailableFrames(const ClownResampler_Step_State* const step)
+{
+	/* Steps from the next clock frame can only affect the frames after the one that it begins in. */
+	return step->position_integer;
+}
+
+static size_t ClownResampler_Step_Read(ClownResampler_Step_State* const step, cc_s32f* const output_buffer_s32, cc_s16l* const output_buffer_s16, const size_t total_frames)
+{
+	const cc_u8f channels = step->channels;
+	const size_t frames_to_read = CLOWNRESAMPLER_MIN(total_frames, step->position_integer);
+	const size_t samples_to_read = frames_to_read * channels;
+	/* The frames that steps have been added to end with the last tap of a step in the final frame that is available. */
+	const size_t samples_remaining = (step->position_integer - frames_to_read + step->total_taps + 1) * channels;
+
+	size_t i;
+
+	/* The output is the running total of the deltas. */
+	for (i = 0; i < samples_to_read; i += channels)
 	{
-		/* If the input buffer is empty, refill it. */
-		if (resampler->input_buffer_start == resampler->input_buffer_end)
+		cc_u8f current_channel;
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
 		{
-			/* It is hard to explain this step-by-step, but essentially there is a trick that we do here:
-			   in order to avoid the resampler reading frames outside of the buffer, we have 'deadzones'
-			   at each end of the buffer. When a new batch of frames is needed, the second deadzone is
-			   copied over the first one, and the second is overwritten by the end of the new frames. */
-
-			/* Move the end of the last batch of data to the start of the buffer */
-			/* (memcpy will not work here since the copy may overlap). */
-			CLOWNRESAMPLER_MEMMOVE(resampler->input_buffer, resampler->input_buffer_end - maximum_radius_in_samples, double_maximum_radius_in_samples * sizeof(*resampler->input_buffer));
-
-			/* Obtain input frames (note that the new frames start after the frames we just copied). */
-			resampler->input_buffer_start = resampler->input_buffer + maximum_radius_in_samples;
-			resampler->input_buffer_end = resampler->input_buffer_start + input_callback((void*)user_data, resampler->input_buffer + double_maximum_radius_in_samples, (CLOWNRESAMPLER_COUNT_OF(resampler->input_buffer) - double_maximum_radius_in_samples) / resampler->low_level.channels) * resampler->low_level.channels;
-
-			/* If the callback returns 0, then we must have reached the end of the input data, so quit. */
-			if (resampler->input_buffer_start == resampler->input_buffer_end)
-				return cc_true;
+			const cc_s32f level = step->levels[current_channel] += step->buffer[i + current_channel];
+
+			if (output_buffer_s32 != NULL)
+				output_buffer_s32[i + current_channel] = level;
+			else
+				output_buffer_s16[i + current_channel] = (cc_s16l)CLOWNRESAMPLER_CLAMP(-0x7FFF - 1, 0x7FFF, level);
 		}
+	}
 
-		/* Call the actual resampler. */
+	/* Move the frames that have not been read to the start of the buffer, and clear the space that they leave behind. */
+	CLOWNRESAMPLER_MEMMOVE(step->buffer, step->buffer + samples_to_read, samples_remaining * sizeof(*step->buffer));
+	CLOWNRESAMPLER_ZERO(step->buffer + samples_remaining, samples_to_read * sizeof(*step->buffer));
+
+	step->position_integer -= frames_to_read;
+
+	return frames_to_read;
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_Step_ReadToS32(ClownResampler_Step_State* const step, cc_s32f* const output_buffer, const size_t total_frames)
+{
+	return ClownResampler_Step_Read(step, output_buffer, NULL, total_frames);
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_Step_ReadToS16(ClownResampler_Step_State* const step, cc_s16l* const output_buffer, const size_t total_frames)
+{
+	return ClownResampler_Step_Read(step, NULL, output_buffer, total_frames);
+}
+
+#endif /* CLOWNRESAMPLER_NO_STEP_API */
+
+#ifndef CLOWNRESAMPLER_NO_FLOAT_API
+#define CLOWNRESAMPLER_NO_FLOAT_API
+
+/* Floating-Point API */
+
+CLOWNRESAMPLER_API void ClownResampler_PrecomputeFloat(ClownResampler_PrecomputedFloat* const precomputed, float* const kernel_table, const cc_u32f kernel_radius, const cc_u32f kernel_resolution)
+{
+	const size_t total_entries = (size_t)kernel_radius * 2 * kernel_resolution;
+
+	size_t i;
+
+	precomputed->kernel_radius = kernel_radius;
+	precomputed->kernel_resolution = kernel_resolution;
+	precomputed->lanczos_kernel_table = kernel_table;
+
+	/* This is the same as the integer table without 'CLOWNRESAMPLER_SYMMETRIC_KERNEL', but with the right edge of the
+	   kernel on the end, so that the table can be interpolated whether 'CLOWNRESAMPLER_INTERPOLATE_KERNEL' is defined or not. */
+	for (i = 0; i < total_entries; ++i)
+		kernel_table[i] = (float)ClownResampler_LanczosKernel(((double)i / (double)total_entries * 2.0 - 1.0) * (double)kernel_radius, (double)kernel_radius);
+
+	kernel_table[total_entries] = 0.0f;
+}
+
+static void ClownResampler_AccumulateFloat_Scalar(float* const output_frame, const cc_u8f channels, const float* const input_buffer, const size_t total_frames, const float* const kernel)
+{
+	size_t frame_index;
+
+	for (frame_index = 0; frame_index < total_frames; ++frame_index)
+	{
+		const float* const frame = &input_buffer[frame_index * channels];
+
+		cc_u8f current_channel;
+
+		for (current_channel = 0; current_channel < channels; ++current_channel)
+			output_frame[current_channel] += frame[current_channel] * kernel[frame_index];
+	}
+}
+
+#ifdef CLOWNRESAMPLER_X86_SIMD
+/* Unlike the integer routines, this does not produce exactly the same output as the scalar version, since the products
+   are summed in a different order. */
+static CLOWNRESAMPLER_TARGET("sse") void ClownResampler_AccumulateFloat_SSE(float* const output_frame, const cc_u8f channels, const float* const input_buffer, const size_t total_frames, const float* const kernel)
+{
+	cc_u8f current_channel;
+	size_t frame_index;
+	float lanes[4];
+
+	if (channels < 4)
+	{
+		/* With fewer than four channels, each vector holds multiple frames. */
+		__m128 accumulator = _mm_setzero_ps();
+
+		frame_index = 0;
+
+		if (channels == 1)
 		{
-			size_t input_frames;
+			for (; frame_index + 4 <= total_frames; frame_index += 4)
+				accumulator = _mm_add_ps(accumulator, _mm_mul_ps(_mm_loadu_ps(&input_buffer[frame_index]), _mm_loadu_ps(&kernel[frame_index])));
+		}
+		else if (channels == 2)
+		{
+			for (; frame_index + 4 <= total_frames; frame_index += 4)
+			{
+				/* Each kernel value is used for both channels of its frame. */
+				const __m128 kernel_values = _mm_loadu_ps(&kernel[frame_index]);
+
+				accumulator = _mm_add_ps(accumulator, _mm_mul_ps(_mm_loadu_ps(&input_buffer[frame_index * 2 + 0]), _mm_unpacklo_ps(kernel_values, kernel_values)));
+				accumulator = _mm_add_ps(accumulator, _mm_mul_ps(_mm_loadu_ps(&input_buffer[frame_index * 2 + 4]), _mm_unpackhi_ps(kernel_values, kernel_values)));
+			}
+		}
 
-			const size_t radius_in_samples = resampler->low_level.lowest_level.integer_stretched_kernel_radius * resampler->low_level.channels;
+		_mm_storeu_ps(lanes, accumulator);
 
-			input_frames = (resampler->input_buffer_end - resampler->input_buffer_start) / resampler->low_level.channels;
-			reached_end_of_output_buffer = ClownResampler_LowLevel_Resample(&resampler->low_level, precomputed, resampler->input_buffer_start - radius_in_samples, &input_frames, output_callback, user_data) == 0;
+		for (current_channel = 0; current_channel < 4; ++current_channel)
+			output_frame[current_channel % channels] += lanes[current_channel];
 
-			/* Increment input and output pointers. */
-			resampler->input_buffer_start = resampler->input_buffer_end - input_frames * resampler->low_level.channels;
+		/* Do the leftover frames. */
+		ClownResampler_AccumulateFloat_Scalar(output_frame, channels, &input_buffer[frame_index * channels], total_frames - frame_index, &kernel[frame_index]);
+	}
+	else
+	{
+		/* With four or more channels, each vector holds four channels of a single frame. */
+		const cc_u8f vector_channels = channels / 4 * 4;
+
+		__m128 accumulators[(CLOWNRESAMPLER_MAXIMUM_CHANNELS + 3) / 4];
+
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+			accumulators[current_channel / 4] = _mm_setzero_ps();
+
+		for (frame_index = 0; frame_index < total_frames; ++frame_index)
+		{
+			const float* const frame = &input_buffer[frame_index * channels];
+			const __m128 kernel_value = _mm_set1_ps(kernel[frame_index]);
+
+			for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+				accumulators[current_channel / 4] = _mm_add_ps(accumulators[current_channel / 4], _mm_mul_ps(_mm_loadu_ps(&frame[current_channel]), kernel_value));
+
+			for (; current_channel < channels; ++current_channel)
+				output_frame[current_channel] += frame[current_channel] * kernel[frame_index];
 		}
-	} while (!reached_end_of_output_buffer);
 
-	return cc_false;
+		for (current_channel = 0; current_channel < vector_channels; current_channel += 4)
+		{
+			cc_u8f i;
+
+			_mm_storeu_ps(lanes, accumulators[current_channel / 4]);
+
+			for (i = 0; i < 4; ++i)
+				output_frame[current_channel + i] += lanes[i];
+		}
+	}
 }
+#endif
 
-#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_API */
+static ClownResampler_AccumulateFloatFunction ClownResampler_SelectAccumulateFloatFunction(const cc_u8f channels)
+{
+#ifdef CLOWNRESAMPLER_X86_SIMD
+	/* SSE2 implies SSE, which is all that is needed here. */
+	if ((channels == 1 || channels == 2 || channels >= 4) && ClownResampler_CPUSupportsSSE2())
+		return ClownResampler_AccumulateFloat_SSE;
+#else
+	(void)channels;
+#endif
 
-#if !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST) && !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_API)
-#define CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST
+	return ClownResampler_AccumulateFloat_Scalar;
+}
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_Adjust(ClownResampler_HighLevel_State* const resampler, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+/* The floating-point version of 'ClownResampler_ResampleFrame'. The frames that the kernel covers are the same, but the
+   kernel values are gathered into a contiguous array in batches, which are then convolved with the frames. */
+static void ClownResampler_ResampleFrameFloat(const ClownResampler_AccumulateFloatFunction accumulate, const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_PrecomputedFloat* const precomputed, float* const output_frame, const cc_u8f channels, const float* const input_buffer, const size_t input_start, const size_t input_end, const size_t position_integer, const cc_u32f position_fractional)
 {
-	/* TODO: Cache the inputs to `ClownResampler_LowLevel_Adjust` instead. */
-	const ClownResampler_LowLevel_State state_backup = resampler->low_level;
+	/* Calculate the bounds of the kernel convolution. */
+	const size_t min_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_CEILING(position_fractional + configuration->stretched_kernel_radius_delta);
+	const size_t max_relative = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position_fractional + configuration->stretched_kernel_radius);
+	const size_t min = position_integer + min_relative;
+	const size_t max = position_integer + configuration->integer_stretched_kernel_radius + max_relative;
+
+	/* Frames outside of the input buffer are silent, so skip them. */
+	const size_t start = CLOWNRESAMPLER_MAX(min, input_start);
+	const size_t end = CLOWNRESAMPLER_MAX(start, CLOWNRESAMPLER_MIN(max, input_end));
+	const size_t total_frames = end - start;
+
+	const float* const kernel_table = precomputed->lanczos_kernel_table;
+#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+	const size_t last_kernel_position = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER((size_t)precomputed->kernel_radius * 2 * precomputed->kernel_resolution) - 1;
+	size_t kernel_position = ClownResampler_FixedPointMultiplyWide(configuration->kernel_step_size, CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(min_relative) - position_fractional) + (start - min) * configuration->kernel_step_size;
+#else
+	size_t kernel_position = CLOWNRESAMPLER_FIXED_POINT_MULTIPLY(configuration->kernel_step_size, (CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(min_relative) - position_fractional)) + (start - min) * configuration->kernel_step_size;
+#endif
+
+	cc_u8f current_channel;
+	size_t frames_done;
+	float kernel[0x40];
+
+	/* The configuration must have been made for this kernel. */
+	CLOWNRESAMPLER_ASSERT(precomputed->kernel_radius == configuration->kernel_radius && precomputed->kernel_resolution == configuration->kernel_resolution);
 
-	if (!ClownResampler_LowLevel_Adjust(&resampler->low_level, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate))
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] = 0.0f;
+
+	for (frames_done = 0; frames_done < total_frames; frames_done += CLOWNRESAMPLER_COUNT_OF(kernel))
 	{
-		resampler->low_level = state_backup;
-		return cc_false;
+		const size_t frames_to_do = CLOWNRESAMPLER_MIN(CLOWNRESAMPLER_COUNT_OF(kernel), total_frames - frames_done);
+
+		size_t i;
+
+		for (i = 0; i < frames_to_do; ++i)
+		{
+		#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+			const size_t position = CLOWNRESAMPLER_MIN(kernel_position, last_kernel_position);
+			const size_t index = CLOWNRESAMPLER_TO_INTEGER_FROM_FIXED_POINT_FLOOR(position);
+			const float fraction = (float)(position % CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE) * (1.0f / CLOWNRESAMPLER_FIXED_POINT_FRACTIONAL_SIZE);
+
+			kernel[i] = kernel_table[index] + (kernel_table[index + 1] - kernel_table[index]) * fraction;
+		#else
+			CLOWNRESAMPLER_ASSERT(kernel_position < CLOWNRESAMPLER_FLOAT_KERNEL_TABLE_LENGTH((size_t)precomputed->kernel_radius, precomputed->kernel_resolution));
+
+			kernel[i] = kernel_table[kernel_position];
+		#endif
+			kernel_position += configuration->kernel_step_size;
+		}
+
+		accumulate(output_frame, channels, &input_buffer[(start - input_start + frames_done) * channels], frames_to_do, kernel);
 	}
 
-	/* Fail if the ratio is too large. See the warning in this function's documentation for more information. */
-	if (resampler->low_level.lowest_level.integer_stretched_kernel_radius > resampler->maximum_integer_stretched_kernel_radius)
+	for (current_channel = 0; current_channel < channels; ++current_channel)
+		output_frame[current_channel] *= configuration->float_sample_normaliser;
+}
+
+CLOWNRESAMPLER_API void ClownResampler_LowestLevel_ResampleFloat(const ClownResampler_LowestLevel_Configuration* const configuration, const ClownResampler_PrecomputedFloat* const precomputed, float* const output_frame, const cc_u8f channels, const float* const input_buffer, const size_t position_integer, const cc_u32f position_fractional)
+{
+	ClownResampler_ResampleFrameFloat(ClownResampler_AccumulateFloat_Scalar, configuration, precomputed, output_frame, channels, input_buffer, 0, (size_t)-1, position_integer, position_fractional);
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_LowLevel_InitFloat(ClownResampler_LowLevel_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	/* Initialisation only needs the kernel's radius and resolution, which both kinds of table have. */
+	ClownResampler_Precomputed integer_precomputed;
+
+	integer_precomputed.kernel_radius = precomputed->kernel_radius;
+	integer_precomputed.kernel_resolution = precomputed->kernel_resolution;
+	integer_precomputed.lanczos_kernel_table = NULL;
+
+	resampler->accumulate_float = ClownResampler_SelectAccumulateFloatFunction(channels);
+
+	return ClownResampler_LowLevel_Init(resampler, &integer_precomputed, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+}
+
+/* Produces frames until either the output buffer is full or the position reaches 'total_input_frames'.
+   'input_start' and 'input_end' are the same as they are for 'ClownResampler_ResampleFrame'. */
+static size_t ClownResampler_LowLevel_ResampleFramesToFloat(ClownResampler_LowLevel_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const float* const input_buffer, const size_t input_start, const size_t input_end, const size_t total_input_frames, float* const output_buffer, const size_t total_output_frames)
+{
+	const cc_u8f channels = resampler->channels;
+
+	size_t frames_done;
+
+	for (frames_done = 0; frames_done < total_output_frames && resampler->position_integer < total_input_frames; ++frames_done)
 	{
-		resampler->low_level = state_backup;
-		return cc_false;
+		float* const output_frame = &output_buffer[frames_done * channels];
+
+		if (resampler->passthrough && *ClownResampler_LowLevel_GetPositionFractional(resampler) == 0)
+		{
+			const float* const input_frame = (const float*)ClownResampler_LowLevel_GetPassthroughFrame(resampler, resampler->position_integer, input_buffer, channels * sizeof(*input_buffer), input_start, input_end);
+
+			cc_u8f current_channel;
+
+			for (current_channel = 0; current_channel < channels; ++current_channel)
+				output_frame[current_channel] = input_frame == NULL ? 0.0f : input_frame[current_channel];
+		}
+		else
+		{
+			cc_u32f position_fractional = resampler->position_fractional;
+
+		#ifdef CLOWNRESAMPLER_POLYPHASE
+			/* The filter-bank is fixed point, so the kernel table is used instead, which needs the phase as a 16.16 fraction. */
+			if (resampler->lowest_level.polyphase.total_phases != 0)
+				position_fractional = CLOWNRESAMPLER_TO_FIXED_POINT_FROM_INTEGER(resampler->position_phase) / resampler->lowest_level.polyphase.total_phases;
+		#endif
+
+			ClownResampler_ResampleFrameFloat(resampler->accumulate_float, &resampler->lowest_level, precomputed, output_frame, channels, input_buffer, input_start, input_end, resampler->position_integer, position_fractional);
+		}
+
+		ClownResampler_LowLevel_AdvancePosition(resampler, &resampler->position_integer, ClownResampler_LowLevel_GetPositionFractional(resampler));
 	}
 
-	/* Freak-out if the ratio is so high that the kernel radius would exceed the size of the input buffer. */
-	if (resampler->low_level.lowest_level.integer_stretched_kernel_radius * 2 >= CLOWNRESAMPLER_COUNT_OF(resampler->input_buffer) / resampler->low_level.channels)
-	{
-		resampler->low_level = state_backup;
+	return frames_done;
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleToFloat(ClownResampler_LowLevel_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const float* const input_buffer, size_t* const total_input_frames, float* const output_buffer, const size_t total_output_frames)
+{
+	/* The input buffer is padded, so there is no need to check the bounds of the kernel. */
+	const size_t frames_done = ClownResampler_LowLevel_ResampleFramesToFloat(resampler, precomputed, input_buffer, 0, (size_t)-1, *total_input_frames, output_buffer, total_output_frames);
+
+	ClownResampler_LowLevel_DiscardInput(resampler, total_input_frames);
+
+	return frames_done;
+}
+
+CLOWNRESAMPLER_API size_t ClownResampler_LowLevel_ResampleUnpaddedToFloat(ClownResampler_LowLevel_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const float* const input_buffer, const size_t total_input_frames, float* const output_buffer, const size_t total_output_frames)
+{
+	const size_t padding_frames = resampler->lowest_level.integer_stretched_kernel_radius;
+
+	return ClownResampler_LowLevel_ResampleFramesToFloat(resampler, precomputed, input_buffer, padding_frames, padding_frames + total_input_frames, total_input_frames, output_buffer, total_output_frames);
+}
+
+/* Returns the buffer that the input frames are stored in. */
+static float* ClownResampler_HighLevelFloat_InputBuffer(const ClownResampler_HighLevelFloat_State* const resampler)
+{
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+	if (resampler->input_buffer == NULL)
+		return (float*)resampler->default_input_buffer;
+#endif
+
+	return resampler->input_buffer;
+}
+
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevelFloat_InitWithBuffer(ClownResampler_HighLevelFloat_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate, float* const input_buffer, const size_t input_buffer_size)
+{
+	if (channels == 0 || channels > CLOWNRESAMPLER_MAXIMUM_CHANNELS)
 		return cc_false;
-	}
+
+	if (!ClownResampler_LowLevel_InitFloat(&resampler->low_level, precomputed, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate))
+		return cc_false;
+
+	resampler->leading_padding_frames_needed = resampler->trailing_padding_frames_remaining = resampler->low_level.lowest_level.integer_stretched_kernel_radius;
+
+	resampler->input_buffer = input_buffer;
+	resampler->input_buffer_size = input_buffer_size;
+
+	/* The buffer must have room for the kernel on either side of at least one frame. */
+	if (resampler->low_level.lowest_level.integer_stretched_kernel_radius * 2 >= input_buffer_size / channels)
+		return cc_false;
+
+	ClownResampler_InitInputBuffer(input_buffer, sizeof(*input_buffer), resampler->low_level.lowest_level.integer_stretched_kernel_radius * channels, &resampler->input_buffer_start, &resampler->input_buffer_end);
 
 	return cc_true;
 }
 
-#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_ADJUST */
+#ifndef CLOWNRESAMPLER_NO_DEFAULT_INPUT_BUFFER
+CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevelFloat_Init(ClownResampler_HighLevelFloat_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	if (!ClownResampler_HighLevelFloat_InitWithBuffer(resampler, precomputed, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate, resampler->default_input_buffer, CLOWNRESAMPLER_COUNT_OF(resampler->default_input_buffer)))
+		return cc_false;
 
-#if !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END) && !defined(CLOWNRESAMPLER_NO_HIGH_LEVEL_API)
-#define CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END
+	/* As in 'ClownResampler_HighLevel_Init'. */
+	resampler->input_buffer = NULL;
+	return cc_true;
+}
+#endif
 
-typedef struct ClownResampler_CallbackWrapperData
+typedef struct ClownResampler_HighLevelFloat_ReadInputContext
 {
-	ClownResampler_HighLevel_State *resampler;
-	ClownResampler_OutputCallback output_callback;
-	void *user_data;
-} ClownResampler_CallbackWrapperData;
+	ClownResampler_InputCallbackFloat input_callback;
+	const void *user_data;
+} ClownResampler_HighLevelFloat_ReadInputContext;
 
-static size_t ClownResampler_PaddingCallback(void* const user_data, cc_s16l* const buffer, const size_t total_frames)
+/* Calls the input callback, in the form that 'ClownResampler_FillInputBuffer' takes. */
+static size_t ClownResampler_HighLevelFloat_ReadInput(const void* const context, void* const buffer, const size_t total_frames)
 {
-	const ClownResampler_CallbackWrapperData* const data = (ClownResampler_CallbackWrapperData*)user_data;
-	const size_t frames_to_do = CLOWNRESAMPLER_MIN(total_frames, data->resampler->trailing_padding_frames_remaining);
+	const ClownResampler_HighLevelFloat_ReadInputContext* const data = (const ClownResampler_HighLevelFloat_ReadInputContext*)context;
+
+	return data->input_callback((void*)data->user_data, (float*)buffer, total_frames);
+}
 
-	CLOWNRESAMPLER_ZERO(buffer, frames_to_do * data->resampler->low_level.channels * sizeof(*buffer));
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevelFloat_Resample(ClownResampler_HighLevelFloat_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, const ClownResampler_InputCallbackFloat input_callback, float* const output_buffer, const size_t total_output_frames, const void* const user_data)
+{
+	const size_t radius_in_samples = resampler->low_level.lowest_level.integer_stretched_kernel_radius * resampler->low_level.channels;
+	float* const input_buffer = ClownResampler_HighLevelFloat_InputBuffer(resampler);
 
-	data->resampler->trailing_padding_frames_remaining -= frames_to_do;
+	ClownResampler_HighLevelFloat_ReadInputContext context;
+	size_t frames_done = 0;
 
-	return frames_to_do;
+	context.input_callback = input_callback;
+	context.user_data = user_data;
+
+	while (frames_done < total_output_frames && ClownResampler_FillInputBuffer(input_buffer, resampler->input_buffer_size, sizeof(*input_buffer), resampler->low_level.channels, radius_in_samples, &resampler->leading_padding_frames_needed, &resampler->input_buffer_start, &resampler->input_buffer_end, ClownResampler_HighLevelFloat_ReadInput, &context))
+	{
+		size_t input_frames = (resampler->input_buffer_end - resampler->input_buffer_start) / resampler->low_level.channels;
+
+		frames_done += ClownResampler_LowLevel_ResampleToFloat(&resampler->low_level, precomputed, &input_buffer[resampler->input_buffer_start - radius_in_samples], &input_frames, &output_buffer[frames_done * resampler->low_level.channels], total_output_frames - frames_done);
+
+		/* Increment input pointer. */
+		resampler->input_buffer_start = resampler->input_buffer_end - input_frames * resampler->low_level.channels;
+	}
+
+	return frames_done;
 }
 
-static cc_bool ClownResampler_OutputCallbackWrapper(void* const user_data, const cc_s32f* const frame, const cc_u8f total_samples)
+static size_t ClownResampler_HighLevelFloat_PaddingCallback(void* const user_data, float* const buffer, const size_t total_frames)
 {
-	const ClownResampler_CallbackWrapperData* const data = (ClownResampler_CallbackWrapperData*)user_data;
+	ClownResampler_HighLevelFloat_State* const resampler = (ClownResampler_HighLevelFloat_State*)user_data;
 
-	return data->output_callback(data->user_data, frame, total_samples);
+	return ClownResampler_ReadPadding(buffer, resampler->low_level.channels * sizeof(*buffer), &resampler->trailing_padding_frames_remaining, total_frames);
 }
 
-CLOWNRESAMPLER_API cc_bool ClownResampler_HighLevel_ResampleEnd(ClownResampler_HighLevel_State* const resampler, const ClownResampler_Precomputed* const precomputed, const ClownResampler_OutputCallback output_callback, const void* const user_data)
+CLOWNRESAMPLER_API size_t ClownResampler_HighLevelFloat_ResampleEnd(ClownResampler_HighLevelFloat_State* const resampler, const ClownResampler_PrecomputedFloat* const precomputed, float* const output_buffer, const size_t total_output_frames)
 {
-	ClownResampler_CallbackWrapperData data;
-	data.resampler = resampler;
-	data.output_callback = output_callback;
-	data.user_data = (void*)user_data;
-
-	return ClownResampler_HighLevel_Resample(resampler, precomputed, ClownResampler_PaddingCallback, ClownResampler_OutputCallbackWrapper, &data);
+	return ClownResampler_HighLevelFloat_Resample(resampler, precomputed, ClownResampler_HighLevelFloat_PaddingCallback, output_buffer, total_output_frames, resampler);
 }
 
-#endif /* CLOWNRESAMPLER_NO_HIGH_LEVEL_RESAMPLE_END */
+#endif /* CLOWNRESAMPLER_NO_FLOAT_API */
 
 #endif /* CLOWNRESAMPLER_IMPLEMENTATION */
+
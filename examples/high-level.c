@@ -44,16 +44,11 @@ streamed piece by piece.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
 static ClownResampler_HighLevel_State resampler;
 static drmp3 mp3_decoder;
 static unsigned int total_channels;
 
-typedef struct ResamplerCallbackData
-{
-	ma_int16 *output_pointer;
-	ma_uint32 output_buffer_frames_remaining;
-} ResamplerCallbackData;
-
 static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
 {
 	(void)user_data;
@@ -62,48 +57,18 @@ static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t to
 	return drmp3_read_pcm_frames_s16(&mp3_decoder, total_frames, buffer);
 }
 
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
-{
-	ResamplerCallbackData* const callback_data = (ResamplerCallbackData*)user_data;
-
-	cc_u8f i;
-
-	/* Output the frame. */
-	for (i = 0; i < total_samples; ++i)
-	{
-		cc_s32f sample;
-
-		sample = frame[i];
-
-		/* Clamp the sample to 16-bit. */
-		if (sample > 0x7FFF)
-			sample = 0x7FFF;
-		else if (sample < -0x7FFF)
-			sample = -0x7FFF;
-
-		/* Push the sample to the output buffer. */
-		*callback_data->output_pointer++ = (ma_int16)sample;
-	}
-
-	/* Signal whether there is more room in the output buffer. */
-	return --callback_data->output_buffer_frames_remaining != 0;
-}
-
 static void AudioCallback(ma_device *device, void *output, const void *input, ma_uint32 frame_count)
 {
-	ResamplerCallbackData callback_data;
+	size_t frames_done;
 
 	(void)device;
 	(void)input;
 
-	callback_data.output_pointer = (ma_int16*)output;
-	callback_data.output_buffer_frames_remaining = frame_count;
-
-	/* Resample the decoded audio data. */
-	ClownResampler_HighLevel_Resample(&resampler, &precomputed, ResamplerInputCallback, ResamplerOutputCallback, &callback_data);
+	/* Resample the decoded audio data straight into the output buffer. */
+	frames_done = ClownResampler_HighLevel_ResampleToS16(&resampler, &precomputed, ResamplerInputCallback, (cc_s16l*)output, frame_count, NULL);
 
 	/* If there are no more samples left, then fill the remaining space in the buffer with 0. */
-	memset(callback_data.output_pointer, 0, callback_data.output_buffer_frames_remaining * total_channels * sizeof(ma_int16));
+	memset((ma_int16*)output + frames_done * total_channels, 0, (frame_count - frames_done) * total_channels * sizeof(ma_int16));
 }
 
 int main(int argc, char **argv)
@@ -157,11 +122,11 @@ int main(int argc, char **argv)
 				/******************************/
 
 				/* Precompute the Lanczos kernel. */
-				ClownResampler_Precompute(&precomputed);
+				ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
 
 				/* Create a resampler that converts from the sample rate of the MP3 to the sample rate of the playback device. */
 				/* The low-pass filter is set to 44100Hz since that should allow all human-perceivable frequencies through. */
-				ClownResampler_HighLevel_Init(&resampler, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
+				ClownResampler_HighLevel_Init(&resampler, &precomputed, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
 
 				/*****************************************/
 				/* Finished initialising clownresampler. */
@@ -45,60 +45,25 @@ streamed piece by piece.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
 static ClownResampler_LowLevel_State resampler;
 static unsigned int total_channels;
 static drmp3_int16 *resampler_input_buffer;
 static size_t resampler_input_buffer_total_frames;
-static size_t resampler_input_buffer_frames_remaining;
-
-typedef struct ResamplerCallbackData
-{
-	ma_int16 *output_pointer;
-	ma_uint32 output_buffer_frames_remaining;
-} ResamplerCallbackData;
-
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
-{
-	ResamplerCallbackData* const callback_data = (ResamplerCallbackData*)user_data;
-
-	cc_u8f i;
-
-	/* Output the frame. */
-	for (i = 0; i < total_samples; ++i)
-	{
-		cc_s32f sample;
-
-		sample = frame[i];
-
-		/* Clamp the sample to 16-bit. */
-		if (sample > 0x7FFF)
-			sample = 0x7FFF;
-		else if (sample < -0x7FFF)
-			sample = -0x7FFF;
-
-		/* Push the sample to the output buffer. */
-		*callback_data->output_pointer++ = (ma_int16)sample;
-	}
-
-	/* Signal whether there is more room in the output buffer. */
-	return --callback_data->output_buffer_frames_remaining != 0;
-}
 
 static void AudioCallback(ma_device *device, void *output, const void *input, ma_uint32 frame_count)
 {
-	ResamplerCallbackData callback_data;
+	size_t frames_done;
 
 	(void)device;
 	(void)input;
 
-	callback_data.output_pointer = (ma_int16*)output;
-	callback_data.output_buffer_frames_remaining = frame_count;
-
-	/* Resample the decoded audio data. */
-	ClownResampler_LowLevel_Resample(&resampler, &precomputed, &resampler_input_buffer[(resampler_input_buffer_total_frames - resampler_input_buffer_frames_remaining) * total_channels], &resampler_input_buffer_frames_remaining, ResamplerOutputCallback, &callback_data);
+	/* Resample the decoded audio data straight into the output buffer. */
+	/* The input buffer has no padding, so the unpadded function is used, which keeps track of its position in the buffer by itself. */
+	frames_done = ClownResampler_LowLevel_ResampleUnpaddedToS16(&resampler, &precomputed, resampler_input_buffer, resampler_input_buffer_total_frames, (cc_s16l*)output, frame_count);
 
 	/* If there are no more samples left, then fill the remaining space in the buffer with 0. */
-	memset(callback_data.output_pointer, 0, callback_data.output_buffer_frames_remaining * total_channels * sizeof(ma_int16));
+	memset((ma_int16*)output + frames_done * total_channels, 0, (frame_count - frames_done) * total_channels * sizeof(ma_int16));
 }
 
 int main(int argc, char **argv)
@@ -161,11 +126,11 @@ int main(int argc, char **argv)
 				/******************************/
 
 				/* Precompute the Lanczos kernel. */
-				ClownResampler_Precompute(&precomputed);
+				ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
 
 				/* Create a resampler that converts from the sample rate of the MP3 to the sample rate of the playback device. */
 				/* The low-pass filter is set to 44100Hz since that should allow all human-perceivable frequencies through. */
-				ClownResampler_LowLevel_Init(&resampler, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
+				ClownResampler_LowLevel_Init(&resampler, &precomputed, mp3_decoder.channels, mp3_decoder.sampleRate, miniaudio_device.sampleRate, 44100);
 
 				/*****************************************/
 				/* Finished initialising clownresampler. */
@@ -176,8 +141,8 @@ int main(int argc, char **argv)
 				/*****************************************/
 
 				/* Create a buffer to hold the decoded PCM data. */
-				/* clownresampler's low-level API requires that this buffer have padding at its beginning and end. */
-				resampler_input_buffer = (drmp3_int16*)malloc((resampler.integer_stretched_kernel_radius * 2 + total_mp3_pcm_frames) * size_of_frame);
+				/* Since the unpadded functions are used, this buffer does not need any padding at its beginning or end. */
+				resampler_input_buffer = (drmp3_int16*)malloc(total_mp3_pcm_frames * size_of_frame);
 
 				if (resampler_input_buffer == NULL)
 				{
@@ -186,18 +151,12 @@ int main(int argc, char **argv)
 				}
 				else
 				{
-					/* Set the padding samples at the start to 0. */
-					memset(&resampler_input_buffer[0], 0, resampler.integer_stretched_kernel_radius * size_of_frame);
-
 					/* Decode the MP3 to the input buffer. */
-					drmp3_read_pcm_frames_s16(&mp3_decoder, total_mp3_pcm_frames, &resampler_input_buffer[resampler.integer_stretched_kernel_radius * total_channels]);
+					drmp3_read_pcm_frames_s16(&mp3_decoder, total_mp3_pcm_frames, resampler_input_buffer);
 					drmp3_uninit(&mp3_decoder);
 
-					/* Set the padding samples at the end to 0. */
-					memset(&resampler_input_buffer[(resampler.integer_stretched_kernel_radius + total_mp3_pcm_frames) * total_channels], 0, resampler.integer_stretched_kernel_radius * size_of_frame);
-
 					/* Initialise some variables that will be used by the audio callback. */
-					resampler_input_buffer_total_frames = resampler_input_buffer_frames_remaining = total_mp3_pcm_frames;
+					resampler_input_buffer_total_frames = total_mp3_pcm_frames;
 
 					/*****************************************************/
 					/* Finished setting up the resampler's input buffer. */
@@ -0,0 +1,8 @@
+# Runs 'COMMAND', and fails unless it exits with 'EXIT_CODE'. Unlike the
+# 'WILL_FAIL' test property, this does not mistake a crash for the expected
+# failure.
+execute_process(COMMAND ${COMMAND} RESULT_VARIABLE RESULT)
+
+if(NOT RESULT STREQUAL EXIT_CODE)
+	message(FATAL_ERROR "Expected exit code ${EXIT_CODE}, but got '${RESULT}'.")
+endif()
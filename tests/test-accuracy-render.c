@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Resamples sine waves with whichever options this file was compiled with.
+   'RENDER_FUNCTION' must be defined as the name of the function that this file
+   provides, which is one of those declared in 'test-accuracy.h'. */
+
+#include <math.h>
+#include <stddef.h>
+
+#define CLOWNRESAMPLER_IMPLEMENTATION
+#define CLOWNRESAMPLER_STATIC
+#include "../clownresampler.h"
+
+#include "test-accuracy.h"
+
+#define AMPLITUDE 0x3000
+
+typedef struct InputState
+{
+	double step, alias_step; /* In radians per frame. */
+	unsigned long frames_read;
+} InputState;
+
+static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+static ClownResampler_HighLevel_State resampler;
+#ifdef CLOWNRESAMPLER_POLYPHASE
+static ClownResampler_KernelValue polyphase_bank[CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS];
+#endif
+static cc_s32f output_integer[TOTAL_OUTPUT_FRAMES];
+static ClownResampler_PrecomputedFloat precomputed_float;
+static float kernel_table_float[CLOWNRESAMPLER_FLOAT_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+static ClownResampler_HighLevelFloat_State resampler_float;
+static float output_float_buffer[TOTAL_OUTPUT_FRAMES];
+
+static cc_s16l NextFrame(InputState* const state)
+{
+	const double frame = (double)state->frames_read++;
+
+	return (cc_s16l)floor(AMPLITUDE * (sin(frame * state->step) + sin(frame * state->alias_step)) + 0.5);
+}
+
+static size_t InputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
+{
+	size_t i;
+
+	for (i = 0; i < total_frames; ++i)
+		buffer[i] = NextFrame((InputState*)user_data);
+
+	return total_frames;
+}
+
+static size_t InputCallbackFloat(void *user_data, float *buffer, size_t total_frames)
+{
+	size_t i;
+
+	/* The same samples as the integer API is given, so that only the resampling differs. */
+	for (i = 0; i < total_frames; ++i)
+		buffer[i] = (float)NextFrame((InputState*)user_data);
+
+	return total_frames;
+}
+
+int RENDER_FUNCTION(const unsigned long input_sample_rate, const unsigned long output_sample_rate, const double frequency, const double alias_frequency, double* const output, double* const output_float)
+{
+	InputState state;
+	size_t i;
+
+	state.step = 2.0 * 3.14159265358979323846 * frequency / input_sample_rate;
+	state.alias_step = 2.0 * 3.14159265358979323846 * alias_frequency / input_sample_rate;
+
+	ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+
+	if (!ClownResampler_HighLevel_Init(&resampler, &precomputed, 1, input_sample_rate, output_sample_rate, output_sample_rate))
+		return 0;
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	ClownResampler_HighLevel_SetPolyphaseBank(&resampler, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+#endif
+
+	state.frames_read = 0;
+
+	if (ClownResampler_HighLevel_ResampleToS32(&resampler, &precomputed, InputCallback, output_integer, TOTAL_OUTPUT_FRAMES, &state) != TOTAL_OUTPUT_FRAMES)
+		return 0;
+
+	for (i = 0; i < TOTAL_OUTPUT_FRAMES; ++i)
+		output[i] = (double)output_integer[i];
+
+	ClownResampler_PrecomputeFloat(&precomputed_float, kernel_table_float, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+
+	if (!ClownResampler_HighLevelFloat_Init(&resampler_float, &precomputed_float, 1, input_sample_rate, output_sample_rate, output_sample_rate))
+		return 0;
+
+	state.frames_read = 0;
+
+	if (ClownResampler_HighLevelFloat_Resample(&resampler_float, &precomputed_float, InputCallbackFloat, output_float_buffer, TOTAL_OUTPUT_FRAMES, &state) != TOTAL_OUTPUT_FRAMES)
+		return 0;
+
+	for (i = 0; i < TOTAL_OUTPUT_FRAMES; ++i)
+		output_float[i] = (double)output_float_buffer[i];
+
+	return 1;
+}
@@ -0,0 +1,269 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Resamples sine waves with two builds of the resampler, and checks how the
+   candidate build's accuracy compares with that of the reference build.
+   There are four modes:
+   - 'sine' measures the signal-to-noise ratio against an ideal sine wave at
+     the first frequency, in decibels. Everything else, such as noise, rounding
+     errors, and the second frequency aliasing, counts as noise. The candidate
+     must be at least 'margin' decibels better than the reference.
+   - 'alias' measures the ratio of the sine wave at the first frequency to the
+     sine wave that the second frequency aliases to, in decibels, ignoring
+     everything else. The candidate must be at least 'margin' decibels better
+     than the reference.
+   - 'float' measures the signal-to-error ratio against the floating-point API
+     of the same build, in decibels. The candidate must be at least 'margin'
+     decibels better than the reference.
+   - 'difference' measures the largest difference between the candidate and
+     the reference, which must be no more than 'margin'. */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test-accuracy.h"
+
+/* The start of the output is skipped, since the sine waves begin abruptly. */
+#define SKIPPED_FRAMES 0x100
+
+static double reference[TOTAL_OUTPUT_FRAMES], reference_float[TOTAL_OUTPUT_FRAMES];
+static double candidate[TOTAL_OUTPUT_FRAMES], candidate_float[TOTAL_OUTPUT_FRAMES];
+static double residual[TOTAL_OUTPUT_FRAMES];
+
+/* Fits 'a * sin(n * step) + b * cos(n * step) + c' to the output with the method of least squares, and returns the
+   ratio of the power of the sine wave to the power of what is left over. If 'power' is not NULL, then the power of the
+   sine wave is written to it, and, if 'residual' is not NULL, then what is left over is written to it. */
+static double FitSine(const double* const output, const double step, double* const power, double* const residual)
+{
+	double matrix[3][4];
+	double coefficients[3];
+	double signal, noise;
+	size_t i, j, k;
+
+	for (i = 0; i < 3; ++i)
+		for (j = 0; j < 4; ++j)
+			matrix[i][j] = 0.0;
+
+	/* Build the normal equations. */
+	for (i = SKIPPED_FRAMES; i < TOTAL_OUTPUT_FRAMES; ++i)
+	{
+		double basis[3];
+
+		basis[0] = sin(i * step);
+		basis[1] = cos(i * step);
+		basis[2] = 1.0;
+
+		for (j = 0; j < 3; ++j)
+		{
+			for (k = 0; k < 3; ++k)
+				matrix[j][k] += basis[j] * basis[k];
+
+			matrix[j][3] += basis[j] * output[i];
+		}
+	}
+
+	/* Solve them with Gaussian elimination. The matrix is symmetric and positive-definite, so no pivoting is needed. */
+	for (i = 0; i < 3; ++i)
+		for (j = i + 1; j < 3; ++j)
+		{
+			const double factor = matrix[j][i] / matrix[i][i];
+
+			for (k = i; k < 4; ++k)
+				matrix[j][k] -= factor * matrix[i][k];
+		}
+
+	for (i = 3; i-- != 0; )
+	{
+		coefficients[i] = matrix[i][3];
+
+		for (j = i + 1; j < 3; ++j)
+			coefficients[i] -= matrix[i][j] * coefficients[j];
+
+		coefficients[i] /= matrix[i][i];
+	}
+
+	signal = noise = 0.0;
+
+	for (i = SKIPPED_FRAMES; i < TOTAL_OUTPUT_FRAMES; ++i)
+	{
+		const double sine = coefficients[0] * sin(i * step) + coefficients[1] * cos(i * step);
+		const double difference = output[i] - sine - coefficients[2];
+
+		signal += sine * sine;
+		noise += difference * difference;
+
+		if (residual != NULL)
+			residual[i] = difference;
+	}
+
+	if (power != NULL)
+		*power = signal;
+
+	return signal / noise;
+}
+
+/* Returns the step of the sine wave in the output that is nearest to 'step'. The resampler's ratio is fixed point, so
+   the pitch of the output can be slightly off, so the sine wave's frequency is fitted by searching a small range around
+   the expected frequency. */
+static double FindSine(const double* const output, const double step)
+{
+	double low = step * (1.0 - 1e-4), high = step * (1.0 + 1e-4);
+	unsigned int i;
+
+	/* Golden-section search. */
+	for (i = 0; i < 60; ++i)
+	{
+		const double third = (high - low) * 0.381966;
+
+		if (FitSine(output, low + third, NULL, NULL) > FitSine(output, high - third, NULL, NULL))
+			high -= third;
+		else
+			low += third;
+	}
+
+	return (low + high) / 2.0;
+}
+
+/* Returns the signal-to-noise ratio of the output against a sine wave, in decibels. The pitch of the output being
+   slightly off is not counted as noise. */
+static double SignalToNoise(const double* const output, const double step)
+{
+	return 10.0 * log10(FitSine(output, FindSine(output, step), NULL, NULL));
+}
+
+/* Returns the ratio of the power of the sine wave at 'step' to the power of the sine wave at 'alias_step', in
+   decibels. Unlike 'SignalToNoise', this ignores noise and rounding errors, and only counts the aliasing. The first
+   sine wave is removed before the second one is fitted, so that it does not leak into it. */
+static double SignalToAlias(const double* const output, const double step, const double alias_step)
+{
+	double signal, alias;
+
+	FitSine(output, FindSine(output, step), &signal, residual);
+	FitSine(residual, FindSine(residual, alias_step), &alias, NULL);
+
+	return 10.0 * log10(signal / alias);
+}
+
+/* Returns the ratio of the power of the output to the power of its difference from 'expected', in decibels. */
+static double SignalToError(const double* const output, const double* const expected)
+{
+	double signal = 0.0, error = 0.0;
+	size_t i;
+
+	for (i = SKIPPED_FRAMES; i < TOTAL_OUTPUT_FRAMES; ++i)
+	{
+		const double difference = output[i] - expected[i];
+
+		signal += expected[i] * expected[i];
+		error += difference * difference;
+	}
+
+	return error == 0.0 ? 1000.0 : 10.0 * log10(signal / error);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long input_sample_rate, output_sample_rate;
+	double frequency, alias_frequency, margin;
+	const char *mode;
+
+	if (argc < 7)
+	{
+		fputs("Usage: test-accuracy [sine/alias/float/difference] [input sample rate] [output sample rate] [frequency] [alias frequency] [margin]\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	mode = argv[1];
+	input_sample_rate = strtoul(argv[2], NULL, 0);
+	output_sample_rate = strtoul(argv[3], NULL, 0);
+	frequency = strtod(argv[4], NULL);
+	alias_frequency = strtod(argv[5], NULL);
+	margin = strtod(argv[6], NULL);
+
+	if (!RenderReference(input_sample_rate, output_sample_rate, frequency, alias_frequency, reference, reference_float)
+	 || !RenderCandidate(input_sample_rate, output_sample_rate, frequency, alias_frequency, candidate, candidate_float))
+	{
+		fputs("Failed to resample.\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strcmp(mode, "sine") == 0 || strcmp(mode, "alias") == 0 || strcmp(mode, "float") == 0)
+	{
+		double reference_ratio, candidate_ratio;
+
+		if (strcmp(mode, "sine") == 0)
+		{
+			const double step = 2.0 * 3.14159265358979323846 * frequency / output_sample_rate;
+
+			reference_ratio = SignalToNoise(reference, step);
+			candidate_ratio = SignalToNoise(candidate, step);
+		}
+		else if (strcmp(mode, "alias") == 0)
+		{
+			const double step = 2.0 * 3.14159265358979323846 * frequency / output_sample_rate;
+			double alias_step;
+
+			/* Fold the second frequency into the band of the output sample rate, which is where it aliases to. */
+			alias_frequency = fmod(alias_frequency, (double)output_sample_rate);
+
+			if (alias_frequency > output_sample_rate / 2.0)
+				alias_frequency = output_sample_rate - alias_frequency;
+
+			alias_step = 2.0 * 3.14159265358979323846 * alias_frequency / output_sample_rate;
+
+			reference_ratio = SignalToAlias(reference, step, alias_step);
+			candidate_ratio = SignalToAlias(candidate, step, alias_step);
+		}
+		else
+		{
+			reference_ratio = SignalToError(reference, reference_float);
+			candidate_ratio = SignalToError(candidate, candidate_float);
+		}
+
+		printf("Reference: %.1fdB, candidate: %.1fdB\n", reference_ratio, candidate_ratio);
+
+		if (candidate_ratio < reference_ratio + margin)
+		{
+			fputs("The candidate is not accurate enough.\n", stderr);
+			return EXIT_FAILURE;
+		}
+	}
+	else if (strcmp(mode, "difference") == 0)
+	{
+		double largest_difference = 0.0;
+		size_t i;
+
+		for (i = 0; i < TOTAL_OUTPUT_FRAMES; ++i)
+			largest_difference = fabs(candidate[i] - reference[i]) > largest_difference ? fabs(candidate[i] - reference[i]) : largest_difference;
+
+		printf("Largest difference: %.0f\n", largest_difference);
+
+		if (largest_difference > margin)
+		{
+			fputs("The candidate differs too much from the reference.\n", stderr);
+			return EXIT_FAILURE;
+		}
+	}
+	else
+	{
+		fputs("Unknown mode.\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* 'test-accuracy.c' links two copies of 'test-accuracy-render.c', each
+   compiled with different options, so that it can compare their output. */
+
+#ifndef TEST_ACCURACY_H
+#define TEST_ACCURACY_H
+
+#include <stddef.h>
+
+#define TOTAL_OUTPUT_FRAMES 0x2000
+
+/* Resamples one or two sine waves with the integer high-level API into
+   'output', and with the floating-point high-level API into 'output_float'.
+   An 'alias_frequency' of 0 leaves out the second sine wave. Both buffers
+   must hold 'TOTAL_OUTPUT_FRAMES' frames. Returns 0 on failure, and 1
+   otherwise. */
+int RenderReference(unsigned long input_sample_rate, unsigned long output_sample_rate, double frequency, double alias_frequency, double *output, double *output_float);
+int RenderCandidate(unsigned long input_sample_rate, unsigned long output_sample_rate, double frequency, double alias_frequency, double *output, double *output_float);
+
+#endif /* TEST_ACCURACY_H */
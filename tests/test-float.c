@@ -0,0 +1,227 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Resamples pseudo-random noise with the floating-point API, and checks it
+   against the same noise being resampled by the integer API. The integer API
+   rounds along the way, so the two are close, but not identical. Also checks
+   that the low-level API's padded and unpadded functions agree. */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CLOWNRESAMPLER_IMPLEMENTATION
+#define CLOWNRESAMPLER_STATIC
+#include "../clownresampler.h"
+
+#define TOTAL_INPUT_FRAMES 0x2000
+#define MAXIMUM_OUTPUT_FRAMES (TOTAL_INPUT_FRAMES * 3)
+#define MAXIMUM_PADDING_FRAMES 0x100
+
+static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+static ClownResampler_PrecomputedFloat precomputed_float;
+static float kernel_table_float[CLOWNRESAMPLER_FLOAT_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+
+static ClownResampler_HighLevel_State resampler;
+static ClownResampler_HighLevelFloat_State resampler_float;
+static ClownResampler_LowLevel_State low_level_padded, low_level_unpadded;
+#ifdef CLOWNRESAMPLER_POLYPHASE
+/* Every resampler is made for the same rates, so they can all share the same filter-bank. */
+static ClownResampler_KernelValue polyphase_bank[CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS];
+#endif
+
+static cc_s16l input[TOTAL_INPUT_FRAMES * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+static float input_float[(MAXIMUM_PADDING_FRAMES + TOTAL_INPUT_FRAMES + MAXIMUM_PADDING_FRAMES) * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+static cc_s32f output[MAXIMUM_OUTPUT_FRAMES * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+static float output_float[MAXIMUM_OUTPUT_FRAMES * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+static float output_padded[MAXIMUM_OUTPUT_FRAMES * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+static float output_unpadded[MAXIMUM_OUTPUT_FRAMES * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+static const struct
+{
+	cc_u32f input_sample_rate, output_sample_rate, low_pass_filter_sample_rate;
+} rates[] = {
+	{44100, 48000, 48000},
+	{48000, 44100, 44100},
+	{44100, 44100, 44100}, /* Passthrough. */
+	{22050, 44100, 44100},
+	{44100, 22050, 22050},
+	{8000, 22050, 4000}
+};
+
+static const cc_u8f channel_counts[] = {1, 2, 3, 6};
+
+typedef struct InputState
+{
+	cc_u8f channels;
+	size_t frames_read;
+} InputState;
+
+static size_t InputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
+{
+	InputState* const state = (InputState*)user_data;
+	const size_t frames_to_do = CLOWNRESAMPLER_MIN(total_frames, TOTAL_INPUT_FRAMES - state->frames_read);
+	size_t i;
+
+	for (i = 0; i < frames_to_do * state->channels; ++i)
+		buffer[i] = input[state->frames_read * state->channels + i];
+
+	state->frames_read += frames_to_do;
+	return frames_to_do;
+}
+
+static size_t InputCallbackFloat(void *user_data, float *buffer, size_t total_frames)
+{
+	InputState* const state = (InputState*)user_data;
+	const size_t frames_to_do = CLOWNRESAMPLER_MIN(total_frames, TOTAL_INPUT_FRAMES - state->frames_read);
+	size_t i;
+
+	for (i = 0; i < frames_to_do * state->channels; ++i)
+		buffer[i] = (float)input[state->frames_read * state->channels + i];
+
+	state->frames_read += frames_to_do;
+	return frames_to_do;
+}
+
+/* Returns the ratio of the signal's power to the power of its difference from 'reference'. */
+static double SignalToError(const float* const signal, const float* const reference, const size_t total_samples)
+{
+	double signal_power = 0.0, error_power = 0.0;
+	size_t i;
+
+	for (i = 0; i < total_samples; ++i)
+	{
+		const double difference = (double)signal[i] - (double)reference[i];
+
+		signal_power += (double)reference[i] * (double)reference[i];
+		error_power += difference * difference;
+	}
+
+	return error_power == 0.0 ? 1e30 : signal_power / error_power;
+}
+
+static cc_bool Test(const cc_u8f channels, const cc_u32f input_sample_rate, const cc_u32f output_sample_rate, const cc_u32f low_pass_filter_sample_rate)
+{
+	InputState state;
+	size_t frames, frames_float, frames_padded, frames_unpadded, padding_frames, input_frames, i;
+	double integer_ratio, unpadded_ratio;
+
+	if (!ClownResampler_HighLevel_Init(&resampler, &precomputed, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate)
+	 || !ClownResampler_HighLevelFloat_Init(&resampler_float, &precomputed_float, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate)
+	 || !ClownResampler_LowLevel_InitFloat(&low_level_padded, &precomputed_float, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate)
+	 || !ClownResampler_LowLevel_InitFloat(&low_level_unpadded, &precomputed_float, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate))
+	{
+		fputs("Failed to initialise.\n", stderr);
+		return cc_false;
+	}
+
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	ClownResampler_HighLevel_SetPolyphaseBank(&resampler, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+	ClownResampler_LowLevel_SetPolyphaseBank(&low_level_padded, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+	ClownResampler_LowLevel_SetPolyphaseBank(&low_level_unpadded, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+#endif
+
+	/* Resample with the integer high-level API. */
+	state.channels = channels;
+	state.frames_read = 0;
+	frames = ClownResampler_HighLevel_ResampleToS32(&resampler, &precomputed, InputCallback, output, MAXIMUM_OUTPUT_FRAMES, &state);
+	frames += ClownResampler_HighLevel_ResampleEndToS32(&resampler, &precomputed, &output[frames * channels], MAXIMUM_OUTPUT_FRAMES - frames);
+
+	/* Resample with the floating-point high-level API. */
+	state.frames_read = 0;
+	frames_float = ClownResampler_HighLevelFloat_Resample(&resampler_float, &precomputed_float, InputCallbackFloat, output_float, MAXIMUM_OUTPUT_FRAMES, &state);
+	frames_float += ClownResampler_HighLevelFloat_ResampleEnd(&resampler_float, &precomputed_float, &output_float[frames_float * channels], MAXIMUM_OUTPUT_FRAMES - frames_float);
+
+	/* Resample with the floating-point low-level API, both with and without padding. */
+	padding_frames = low_level_padded.lowest_level.integer_stretched_kernel_radius;
+
+	if (padding_frames > MAXIMUM_PADDING_FRAMES)
+	{
+		fputs("The kernel is too wide.\n", stderr);
+		return cc_false;
+	}
+
+	for (i = 0; i < (padding_frames + TOTAL_INPUT_FRAMES + padding_frames) * channels; ++i)
+		input_float[i] = 0.0f;
+
+	for (i = 0; i < TOTAL_INPUT_FRAMES * channels; ++i)
+		input_float[padding_frames * channels + i] = (float)input[i];
+
+	input_frames = TOTAL_INPUT_FRAMES;
+	frames_padded = ClownResampler_LowLevel_ResampleToFloat(&low_level_padded, &precomputed_float, input_float, &input_frames, output_padded, MAXIMUM_OUTPUT_FRAMES);
+	frames_unpadded = ClownResampler_LowLevel_ResampleUnpaddedToFloat(&low_level_unpadded, &precomputed_float, &input_float[padding_frames * channels], TOTAL_INPUT_FRAMES, output_unpadded, MAXIMUM_OUTPUT_FRAMES);
+
+	if (frames_float != frames || frames_padded != frames || frames_unpadded != frames)
+	{
+		fprintf(stderr, "The numbers of frames do not match: %lu, %lu, %lu, and %lu.\n", (unsigned long)frames, (unsigned long)frames_float, (unsigned long)frames_padded, (unsigned long)frames_unpadded);
+		return cc_false;
+	}
+
+	/* The integer output is converted in place, as 'output_padded' is what it is compared against. */
+	for (i = 0; i < frames * channels; ++i)
+		output_padded[i] = (float)output[i];
+
+	integer_ratio = SignalToError(output_float, output_padded, frames * channels);
+
+	/* Both padded and unpadded outputs come from the same kernel values, but the frames outside of the buffer are skipped. */
+	input_frames = TOTAL_INPUT_FRAMES;
+	ClownResampler_LowLevel_InitFloat(&low_level_padded, &precomputed_float, channels, input_sample_rate, output_sample_rate, low_pass_filter_sample_rate);
+#ifdef CLOWNRESAMPLER_POLYPHASE
+	ClownResampler_LowLevel_SetPolyphaseBank(&low_level_padded, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+#endif
+	ClownResampler_LowLevel_ResampleToFloat(&low_level_padded, &precomputed_float, input_float, &input_frames, output_padded, MAXIMUM_OUTPUT_FRAMES);
+	unpadded_ratio = SignalToError(output_unpadded, output_padded, frames * channels);
+
+	printf("%u channels, %lu:%lu:%lu - signal-to-error ratios: %.3g against integer, %.3g unpadded\n", (unsigned int)channels, (unsigned long)input_sample_rate, (unsigned long)output_sample_rate, (unsigned long)low_pass_filter_sample_rate, integer_ratio, unpadded_ratio);
+
+	/* The integer API's rounding errors are only ever a few units, so they should be far quieter than the signal.
+	   The polyphase filter-bank is not used by the floating-point API, and places its taps differently, so the
+	   integer API cannot be compared against when it is enabled. */
+	if (
+	#ifndef CLOWNRESAMPLER_POLYPHASE
+		integer_ratio < 1e6 ||
+	#endif
+		unpadded_ratio < 1e10)
+	{
+		fputs("The outputs do not match.\n", stderr);
+		return cc_false;
+	}
+
+	return cc_true;
+}
+
+int main(void)
+{
+	unsigned long random_state = 1;
+	size_t i, j;
+
+	ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+	ClownResampler_PrecomputeFloat(&precomputed_float, kernel_table_float, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+
+	/* Produce noise with a linear congruential generator. It is kept quiet enough that the integer API never clamps. */
+	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(input); ++i)
+	{
+		random_state = (random_state * 1103515245 + 12345) & 0xFFFFFFFF;
+		input[i] = (cc_s16l)((long)((random_state >> 16) & 0x3FFF) - 0x2000);
+	}
+
+	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(rates); ++i)
+		for (j = 0; j < CLOWNRESAMPLER_COUNT_OF(channel_counts); ++j)
+			if (!Test(channel_counts[j], rates[i].input_sample_rate, rates[i].output_sample_rate, rates[i].low_pass_filter_sample_rate))
+				return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
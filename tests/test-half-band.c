@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Checks which ratios the half-band path is used for. The other tests check
+   that it does not change the output, which they cannot tell apart from it
+   not being used at all. It is only a shortcut for a kernel that is stretched
+   by exactly 1 or 2, so larger ratios, such as 4:1 and 8:1, must not use it. */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CLOWNRESAMPLER_IMPLEMENTATION
+#define CLOWNRESAMPLER_STATIC
+#include "../clownresampler.h"
+
+typedef struct Ratio
+{
+	cc_u32f input_sample_rate;
+	cc_u32f output_sample_rate;
+	cc_u32f low_pass_filter_sample_rate;
+	cc_u8f half_band_factor;
+} Ratio;
+
+static const Ratio ratios[] = {
+	{ 96000, 48000, 48000, 2},
+	{ 88200, 48000, 44100, 2},
+	{ 48000, 96000, 96000, 1},
+	{ 44100, 48000, 48000, 1},
+	{ 44100, 44100, 44100, 1},
+	{ 48000, 48000, 24000, 2},
+	{ 88200, 48000, 48000, 0},
+	{ 96000, 48000, 24000, 0},
+	{192000, 48000, 48000, 0},
+	{384000, 48000, 48000, 0}
+};
+
+int main(void)
+{
+	int exit_code = EXIT_SUCCESS;
+	size_t i;
+
+	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(ratios); ++i)
+	{
+		const Ratio* const ratio = &ratios[i];
+
+		ClownResampler_LowestLevel_Configuration configuration;
+		cc_u8f expected_factor;
+
+	#ifdef CLOWNRESAMPLER_NO_HALF_BAND
+		expected_factor = 0;
+	#else
+		expected_factor = ratio->half_band_factor;
+	#endif
+
+		if (!ClownResampler_LowestLevel_Configure(&configuration, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION, ratio->input_sample_rate, ratio->output_sample_rate, ratio->low_pass_filter_sample_rate))
+		{
+			fprintf(stderr, "Failed to configure %lu -> %lu.\n", (unsigned long)ratio->input_sample_rate, (unsigned long)ratio->output_sample_rate);
+			exit_code = EXIT_FAILURE;
+		}
+		else if (configuration.half_band_factor != expected_factor)
+		{
+			fprintf(stderr, "%lu -> %lu with a low-pass filter of %lu: expected a half-band factor of %u, but got %u.\n", (unsigned long)ratio->input_sample_rate, (unsigned long)ratio->output_sample_rate, (unsigned long)ratio->low_pass_filter_sample_rate, (unsigned int)expected_factor, (unsigned int)configuration.half_band_factor);
+			exit_code = EXIT_FAILURE;
+		}
+	}
+
+	return exit_code;
+}
@@ -16,6 +16,7 @@ PERFORMANCE OF THIS SOFTWARE.
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define DR_FLAC_IMPLEMENTATION
 #define DR_FLAC_NO_OGG
@@ -27,7 +28,29 @@ PERFORMANCE OF THIS SOFTWARE.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+#ifndef CLOWNRESAMPLER_USE_BUILTIN_TABLE
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+#endif
 static ClownResampler_HighLevel_State resampler;
+#ifdef CLOWNRESAMPLER_POLYPHASE
+static ClownResampler_KernelValue polyphase_bank[CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS];
+#endif
+#ifdef USE_CALLER_INPUT_BUFFER
+static cc_s16l input_buffer[0x10000];
+#endif
+#ifdef USE_STATE_COPY
+static ClownResampler_HighLevel_State moved_resampler;
+#endif
+#ifdef USE_ADJUST
+/* The resampler is made with a slightly lower low-pass filter sample rate, and then adjusted to the real one, which must
+   produce the same output as making it with the real one in the first place. */
+#define INITIAL_LOW_PASS_SAMPLE_RATE(low_pass_sample_rate) ((low_pass_sample_rate) / 20 * 19)
+#else
+#define INITIAL_LOW_PASS_SAMPLE_RATE(low_pass_sample_rate) (low_pass_sample_rate)
+#endif
+
+/* Returned when the resampler refuses the sample rates, so that the tests can tell this apart from other failures. */
+#define EXIT_INIT_FAILURE 2
 static drflac *flac_decoder;
 
 static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
@@ -38,26 +61,80 @@ static size_t ResamplerInputCallback(void *user_data, cc_s16l *buffer, size_t to
 	return drflac_read_pcm_frames_s16(flac_decoder, total_frames, buffer);
 }
 
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
+static void WriteSamples(FILE *output_file, const cc_s32f *samples, size_t total_samples)
 {
-	FILE* const output_file = (FILE*)user_data;
+	size_t i;
 
-	cc_u8f i;
-
-	/* Output the frame. */
 	for (i = 0; i < total_samples; ++i)
 	{
 		unsigned int j;
 		unsigned char bytes[4];
 
 		for (j = 0; j < 4; ++j)
-			bytes[j] = (frame[i] >> (8 * j)) & 0xFF;
+			bytes[j] = (samples[i] >> (8 * j)) & 0xFF;
 
 		fwrite(bytes, 1, sizeof(bytes), output_file);
 	}
+}
+
+#ifdef USE_BUFFER_API
+static cc_s32f output_buffer[0x400 * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+#if defined(USE_MIX_API) && !defined(MIX_GAIN)
+#define MIX_GAIN CLOWNRESAMPLER_GAIN_UNITY
+#endif
+
+#ifdef USE_MIX_API
+static unsigned long bus_position;
+
+/* Returns a sample of a sawtooth wave that stands in for audio that is already on the bus. Its period is deliberately
+   awkward, so that it does not line up with the output buffer. */
+static cc_s32f BusSample(const unsigned long index)
+{
+	return (cc_s32f)(index % 0x3E7) * 0x40 - 0x7FFF;
+}
+
+/* Fills the output buffer with the sawtooth wave, for the resampler to mix into. */
+static void FillBus(void)
+{
+	size_t i;
+
+	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(output_buffer); ++i)
+		output_buffer[i] = BusSample(bus_position + i);
+}
+
+/* Subtracts the sawtooth wave from the samples that were mixed into, which leaves only what the resampler added, so that
+   the output can be compared with that of resampling normally. The rest of the buffer must not have been touched. */
+static void RemoveBus(const size_t total_samples)
+{
+	size_t i;
+
+	for (i = 0; i < total_samples; ++i)
+		output_buffer[i] -= BusSample(bus_position + i);
+
+	for (; i < CLOWNRESAMPLER_COUNT_OF(output_buffer); ++i)
+	{
+		if (output_buffer[i] != BusSample(bus_position + i))
+		{
+			fputs("Mixing modified samples past the end of its output.\n", stderr);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	bus_position += total_samples;
+}
+#endif
+#else
+static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
+{
+	FILE* const output_file = (FILE*)user_data;
+
+	/* Output the frame. */
+	WriteSamples(output_file, frame, total_samples);
 
 	return cc_true;
 }
+#endif
 
 int main(int argc, char **argv)
 {
@@ -112,19 +189,91 @@ int main(int argc, char **argv)
 					/* Initialise clownresampler. */
 					/******************************/
 
+				#ifdef CLOWNRESAMPLER_USE_BUILTIN_TABLE
+					/* Use the Lanczos kernel that was precomputed at build time. */
+					precomputed = ClownResampler_builtin_precomputed;
+				#else
 					/* Precompute the Lanczos kernel. */
-					ClownResampler_Precompute(&precomputed);
+					ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+				#endif
 
 					/* Create a resampler that converts from the sample rate of the FLAC file to the sample rate of the playback device. */
-					ClownResampler_HighLevel_Init(&resampler, flac_decoder->channels, input_sample_rate, output_sample_rate, low_pass_sample_rate);
+				#ifdef USE_CALLER_INPUT_BUFFER
+					/* Use a larger input buffer than the default, sized to hold 0x2000 frames at a time. */
+					if (!ClownResampler_HighLevel_InitWithBuffer(&resampler, &precomputed, flac_decoder->channels, input_sample_rate, output_sample_rate, INITIAL_LOW_PASS_SAMPLE_RATE(low_pass_sample_rate), input_buffer, CLOWNRESAMPLER_MIN(CLOWNRESAMPLER_COUNT_OF(input_buffer), ClownResampler_HighLevel_GetInputBufferSize(&precomputed, flac_decoder->channels, input_sample_rate, output_sample_rate, INITIAL_LOW_PASS_SAMPLE_RATE(low_pass_sample_rate), 0x2000))))
+				#else
+					if (!ClownResampler_HighLevel_Init(&resampler, &precomputed, flac_decoder->channels, input_sample_rate, output_sample_rate, INITIAL_LOW_PASS_SAMPLE_RATE(low_pass_sample_rate)))
+				#endif
+					{
+						fputs("Failed to initialise resampler.\n", stderr);
+						drflac_close(flac_decoder);
+						fclose(output_file);
+						return EXIT_INIT_FAILURE;
+					}
+
+				#ifdef USE_ADJUST
+					if (!ClownResampler_HighLevel_Adjust(&resampler, input_sample_rate, output_sample_rate, low_pass_sample_rate))
+					{
+						fputs("Failed to adjust resampler.\n", stderr);
+						drflac_close(flac_decoder);
+						fclose(output_file);
+						return EXIT_FAILURE;
+					}
+				#endif
+
+				#ifdef CLOWNRESAMPLER_POLYPHASE
+					/* Give the resampler somewhere to store its filter-bank, so that it is used. */
+					ClownResampler_HighLevel_SetPolyphaseBank(&resampler, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+				#endif
 
 					/*****************************************/
 					/* Finished initialising clownresampler. */
 					/*****************************************/
 
 					/* Resample the decoded audio data. */
+				#ifdef USE_BUFFER_API
+					{
+						const size_t total_channels = flac_decoder->channels;
+						const size_t total_output_frames = CLOWNRESAMPLER_COUNT_OF(output_buffer) / total_channels;
+
+						size_t frames_done;
+
+						do
+						{
+						#ifdef USE_MIX_API
+							/* Mix into a buffer that already has audio in it. */
+							FillBus();
+							frames_done = ClownResampler_HighLevel_MixToS32(&resampler, &precomputed, ResamplerInputCallback, output_buffer, total_output_frames, MIX_GAIN, NULL);
+							RemoveBus(frames_done * total_channels);
+						#elif defined(USE_STATE_COPY)
+							/* Resample with a copy of the resampler, and clear the original, to make sure that the copy does not depend on it. */
+							moved_resampler = resampler;
+							memset(&resampler, 0, sizeof(resampler));
+							frames_done = ClownResampler_HighLevel_ResampleToS32(&moved_resampler, &precomputed, ResamplerInputCallback, output_buffer, total_output_frames, NULL);
+							resampler = moved_resampler;
+							memset(&moved_resampler, 0, sizeof(moved_resampler));
+						#else
+							frames_done = ClownResampler_HighLevel_ResampleToS32(&resampler, &precomputed, ResamplerInputCallback, output_buffer, total_output_frames, NULL);
+						#endif
+							WriteSamples(output_file, output_buffer, frames_done * total_channels);
+						} while (frames_done == total_output_frames);
+
+						do
+						{
+						#ifdef USE_MIX_API
+							FillBus();
+							frames_done = ClownResampler_HighLevel_MixEndToS32(&resampler, &precomputed, output_buffer, total_output_frames, MIX_GAIN);
+							RemoveBus(frames_done * total_channels);
+						#else
+							frames_done = ClownResampler_HighLevel_ResampleEndToS32(&resampler, &precomputed, output_buffer, total_output_frames);
+						#endif
+							WriteSamples(output_file, output_buffer, frames_done * total_channels);
+						} while (frames_done == total_output_frames);
+					}
+				#else
 					ClownResampler_HighLevel_Resample(&resampler, &precomputed, ResamplerInputCallback, ResamplerOutputCallback, output_file);
 					ClownResampler_HighLevel_ResampleEnd(&resampler, &precomputed, ResamplerOutputCallback, output_file);
+				#endif
 
 					drflac_close(flac_decoder);
 
@@ -28,29 +28,121 @@ PERFORMANCE OF THIS SOFTWARE.
 #include "../clownresampler.h"
 
 static ClownResampler_Precomputed precomputed;
+#ifndef CLOWNRESAMPLER_USE_BUILTIN_TABLE
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+#endif
 static ClownResampler_LowLevel_State resampler;
+#ifdef CLOWNRESAMPLER_POLYPHASE
+static ClownResampler_KernelValue polyphase_bank[CLOWNRESAMPLER_POLYPHASE_MAXIMUM_COEFFICIENTS];
+#endif
 static drflac_int16 *resampler_input_buffer;
 
-static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
+static void WriteSamples(FILE *output_file, const cc_s32f *samples, size_t total_samples)
 {
-	FILE* const output_file = (FILE*)user_data;
+	size_t i;
 
-	cc_u8f i;
-
-	/* Output the frame. */
 	for (i = 0; i < total_samples; ++i)
 	{
 		unsigned int j;
 		unsigned char bytes[4];
 
 		for (j = 0; j < 4; ++j)
-			bytes[j] = (frame[i] >> (8 * j)) & 0xFF;
+			bytes[j] = (samples[i] >> (8 * j)) & 0xFF;
 
 		fwrite(bytes, 1, sizeof(bytes), output_file);
 	}
+}
+
+#ifdef TOTAL_CHANNELS
+/* Spreads the decoded frames across 'TOTAL_CHANNELS' channels, so that channel counts other than the FLAC's can be
+   tested. Each channel is a copy of one of the decoded ones at its own volume, so that no two are the same. This is
+   done in-place, backwards, so that no frame is overwritten before it is read. If there are fewer channels than
+   were decoded, then the first ones are kept, and this is done forwards instead for the same reason. */
+static void ConvertChannels(drflac_int16* const frames, const size_t total_frames, const size_t decoded_channels)
+{
+	size_t frame;
+	size_t channel;
+
+	if (TOTAL_CHANNELS < decoded_channels)
+	{
+		for (frame = 0; frame < total_frames; ++frame)
+			for (channel = 0; channel < TOTAL_CHANNELS; ++channel)
+				frames[frame * TOTAL_CHANNELS + channel] = frames[frame * decoded_channels + channel];
+	}
+	else
+	{
+		frame = total_frames;
+
+		while (frame-- != 0)
+		{
+			channel = TOTAL_CHANNELS;
+
+			while (channel-- != 0)
+				frames[frame * TOTAL_CHANNELS + channel] = (drflac_int16)(frames[frame * decoded_channels + channel % decoded_channels] * (long)(TOTAL_CHANNELS - channel / decoded_channels) / TOTAL_CHANNELS);
+		}
+	}
+}
+#endif
+
+#ifdef USE_BUFFER_API
+static cc_s32f output_buffer[0x400 * CLOWNRESAMPLER_MAXIMUM_CHANNELS];
+
+#if defined(USE_MIX_API) && !defined(MIX_GAIN)
+#define MIX_GAIN CLOWNRESAMPLER_GAIN_UNITY
+#endif
+
+#ifdef USE_MIX_API
+static unsigned long bus_position;
+
+/* Returns a sample of a sawtooth wave that stands in for audio that is already on the bus. Its period is deliberately
+   awkward, so that it does not line up with the output buffer. */
+static cc_s32f BusSample(const unsigned long index)
+{
+	return (cc_s32f)(index % 0x3E7) * 0x40 - 0x7FFF;
+}
+
+/* Fills the output buffer with the sawtooth wave, for the resampler to mix into. */
+static void FillBus(void)
+{
+	size_t i;
+
+	for (i = 0; i < CLOWNRESAMPLER_COUNT_OF(output_buffer); ++i)
+		output_buffer[i] = BusSample(bus_position + i);
+}
+
+/* Subtracts the sawtooth wave from the samples that were mixed into, which leaves only what the resampler added, so that
+   the output can be compared with that of resampling normally. The rest of the buffer must not have been touched. */
+static void RemoveBus(const size_t total_samples)
+{
+	size_t i;
+
+	for (i = 0; i < total_samples; ++i)
+		output_buffer[i] -= BusSample(bus_position + i);
+
+	for (; i < CLOWNRESAMPLER_COUNT_OF(output_buffer); ++i)
+	{
+		if (output_buffer[i] != BusSample(bus_position + i))
+		{
+			fputs("Mixing modified samples past the end of its output.\n", stderr);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	bus_position += total_samples;
+}
+#endif
+#elif !defined(USE_CHUNKS) || defined(USE_UNPADDED_INPUT)
+/* The chunks have their own output buffer, and do not use the callback. */
+static cc_bool ResamplerOutputCallback(void *user_data, const cc_s32f *frame, cc_u8f total_samples)
+{
+	FILE* const output_file = (FILE*)user_data;
+
+	/* Output the frame. */
+	WriteSamples(output_file, frame, total_samples);
 
 	return cc_true;
 }
+#endif
 
 int main(int argc, char **argv)
 {
@@ -98,8 +190,16 @@ int main(int argc, char **argv)
 				}
 				else
 				{
-					const size_t size_of_frame = flac_decoder->channels * sizeof(drflac_int16);
+				#ifdef TOTAL_CHANNELS
+					const size_t total_channels = TOTAL_CHANNELS;
+				#else
 					const size_t total_channels = flac_decoder->channels;
+				#endif
+				#ifndef USE_UNPADDED_INPUT
+					const size_t size_of_frame = total_channels * sizeof(drflac_int16);
+				#endif
+					/* The FLAC is decoded to the input buffer before its channels are converted, so the buffer must fit either. */
+					const size_t size_of_buffer_frame = CLOWNRESAMPLER_MAX(total_channels, flac_decoder->channels) * sizeof(drflac_int16);
 
 					size_t total_flac_pcm_frames;
 
@@ -113,12 +213,22 @@ int main(int argc, char **argv)
 					/* Initialise clownresampler. */
 					/******************************/
 
+				#ifdef CLOWNRESAMPLER_USE_BUILTIN_TABLE
+					/* Use the Lanczos kernel that was precomputed at build time. */
+					precomputed = ClownResampler_builtin_precomputed;
+				#else
 					/* Precompute the Lanczos kernel. */
-					ClownResampler_Precompute(&precomputed);
+					ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+				#endif
 
 					/* Create a resampler that converts from the sample rate of the FLAC to the sample rate of the playback device. */
 					/* The low-pass filter is set to 44100Hz since that should allow all human-perceivable frequencies through. */
-					ClownResampler_LowLevel_Init(&resampler, flac_decoder->channels, input_sample_rate, output_sample_rate, low_pass_sample_rate);
+					ClownResampler_LowLevel_Init(&resampler, &precomputed, total_channels, input_sample_rate, output_sample_rate, low_pass_sample_rate);
+
+				#ifdef CLOWNRESAMPLER_POLYPHASE
+					/* Give the resampler somewhere to store its filter-bank, so that it is used. */
+					ClownResampler_LowLevel_SetPolyphaseBank(&resampler, polyphase_bank, CLOWNRESAMPLER_COUNT_OF(polyphase_bank));
+				#endif
 
 					/*****************************************/
 					/* Finished initialising clownresampler. */
@@ -129,8 +239,13 @@ int main(int argc, char **argv)
 					/*****************************************/
 
 					/* Create a buffer to hold the decoded PCM data. */
+				#ifdef USE_UNPADDED_INPUT
+					/* The unpadded functions do not need this buffer to have any padding. */
+					resampler_input_buffer = (drflac_int16*)malloc(total_flac_pcm_frames * size_of_buffer_frame);
+				#else
 					/* clownresampler's low-level API requires that this buffer have padding at its beginning and end. */
-					resampler_input_buffer = (drflac_int16*)malloc((resampler.lowest_level.integer_stretched_kernel_radius * 2 + total_flac_pcm_frames) * size_of_frame);
+					resampler_input_buffer = (drflac_int16*)malloc((resampler.lowest_level.integer_stretched_kernel_radius * 2 + total_flac_pcm_frames) * size_of_buffer_frame);
+				#endif
 
 					if (resampler_input_buffer == NULL)
 					{
@@ -139,6 +254,32 @@ int main(int argc, char **argv)
 					}
 					else
 					{
+					#ifdef USE_UNPADDED_INPUT
+						/* Decode the FLAC straight to the input buffer. */
+						drflac_read_pcm_frames_s16(flac_decoder, total_flac_pcm_frames, resampler_input_buffer);
+					#ifdef TOTAL_CHANNELS
+						ConvertChannels(resampler_input_buffer, total_flac_pcm_frames, flac_decoder->channels);
+					#endif
+						drflac_close(flac_decoder);
+
+						/*****************************************************/
+						/* Finished setting up the resampler's input buffer. */
+						/*****************************************************/
+
+					#ifdef USE_BUFFER_API
+						for (;;)
+						{
+							const size_t frames_done = ClownResampler_LowLevel_ResampleUnpaddedToS32(&resampler, &precomputed, resampler_input_buffer, total_flac_pcm_frames, output_buffer, CLOWNRESAMPLER_COUNT_OF(output_buffer) / total_channels);
+
+							if (frames_done == 0)
+								break;
+
+							WriteSamples(output_file, output_buffer, frames_done * total_channels);
+						}
+					#else
+						ClownResampler_LowLevel_ResampleUnpadded(&resampler, &precomputed, resampler_input_buffer, total_flac_pcm_frames, ResamplerOutputCallback, output_file);
+					#endif
+					#else
 						size_t resampler_input_buffer_frames_remaining;
 
 						/* Set the padding samples at the start to 0. */
@@ -146,6 +287,9 @@ int main(int argc, char **argv)
 
 						/* Decode the FLAC to the input buffer. */
 						drflac_read_pcm_frames_s16(flac_decoder, total_flac_pcm_frames, &resampler_input_buffer[resampler.lowest_level.integer_stretched_kernel_radius * total_channels]);
+					#ifdef TOTAL_CHANNELS
+						ConvertChannels(&resampler_input_buffer[resampler.lowest_level.integer_stretched_kernel_radius * total_channels], total_flac_pcm_frames, flac_decoder->channels);
+					#endif
 						drflac_close(flac_decoder);
 
 						/* Set the padding samples at the end to 0. */
@@ -156,7 +300,57 @@ int main(int argc, char **argv)
 						/*****************************************************/
 
 						resampler_input_buffer_frames_remaining = total_flac_pcm_frames;
+					#if defined(USE_CHUNKS)
+						{
+							/* Resample the output in chunks, from last to first, as a thread pool might. The number of chunks
+							   is deliberately awkward, so that the chunks start at all sorts of positions. */
+							const size_t total_output_frames = ClownResampler_LowLevel_GetTotalOutputFrames(&resampler, resampler_input_buffer_frames_remaining);
+							const size_t total_chunks = total_output_frames / 0x3E7 + 1;
+							cc_s32f* const chunk_output_buffer = (cc_s32f*)malloc(total_output_frames * total_channels * sizeof(cc_s32f));
+
+							if (chunk_output_buffer == NULL)
+							{
+								fputs("Failed to allocate memory for resampler output buffer.\n", stderr);
+							}
+							else
+							{
+								size_t chunk;
+
+								for (chunk = total_chunks; chunk-- != 0; )
+								{
+									size_t first_output_frame;
+									const size_t total_chunk_frames = ClownResampler_LowLevel_GetChunk(&resampler, resampler_input_buffer_frames_remaining, total_chunks, chunk, &first_output_frame);
+
+									ClownResampler_LowLevel_ResampleChunkToS32(&resampler, &precomputed, resampler_input_buffer, resampler_input_buffer_frames_remaining, first_output_frame, &chunk_output_buffer[first_output_frame * total_channels], total_chunk_frames);
+								}
+
+								WriteSamples(output_file, chunk_output_buffer, total_output_frames * total_channels);
+								free(chunk_output_buffer);
+							}
+						}
+					#elif defined(USE_BUFFER_API)
+						for (;;)
+						{
+							size_t frames_done;
+
+						#ifdef USE_MIX_API
+							/* Mix into a buffer that already has audio in it. */
+							FillBus();
+							frames_done = ClownResampler_LowLevel_MixToS32(&resampler, &precomputed, &resampler_input_buffer[(total_flac_pcm_frames - resampler_input_buffer_frames_remaining) * total_channels], &resampler_input_buffer_frames_remaining, output_buffer, CLOWNRESAMPLER_COUNT_OF(output_buffer) / total_channels, MIX_GAIN);
+							RemoveBus(frames_done * total_channels);
+						#else
+							frames_done = ClownResampler_LowLevel_ResampleToS32(&resampler, &precomputed, &resampler_input_buffer[(total_flac_pcm_frames - resampler_input_buffer_frames_remaining) * total_channels], &resampler_input_buffer_frames_remaining, output_buffer, CLOWNRESAMPLER_COUNT_OF(output_buffer) / total_channels);
+						#endif
+
+							if (frames_done == 0)
+								break;
+
+							WriteSamples(output_file, output_buffer, frames_done * total_channels);
+						}
+					#else
 						ClownResampler_LowLevel_Resample(&resampler, &precomputed, resampler_input_buffer, &resampler_input_buffer_frames_remaining, ResamplerOutputCallback, output_file);
+					#endif
+					#endif
 
 						free(resampler_input_buffer);
 
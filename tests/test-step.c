@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Renders a square wave with the band-limited step API, and checks it against
+   the same square wave being rendered sample-by-sample and passed through the
+   high-level API. Also checks that the steps add up to exactly the level that
+   they are meant to reach. */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CLOWNRESAMPLER_IMPLEMENTATION
+#define CLOWNRESAMPLER_STATIC
+#include "../clownresampler.h"
+
+#define CLOCK_RATE 223721 /* A Sega Mega Drive's PSG. */
+#define OUTPUT_SAMPLE_RATE 48000
+#define CLOCKS_PER_FRAME (CLOCK_RATE / 60)
+#define TOTAL_CLOCK_FRAMES 60
+#define HALF_PERIOD 97 /* In clocks. */
+#define AMPLITUDE 0x2000
+
+static ClownResampler_Precomputed precomputed;
+static ClownResampler_KernelValue kernel_table[CLOWNRESAMPLER_KERNEL_TABLE_LENGTH(CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION)];
+static ClownResampler_HighLevel_State resampler;
+static ClownResampler_Step_State step;
+static cc_s32f step_buffer[0x1000];
+static cc_s32f step_output[OUTPUT_SAMPLE_RATE * 2];
+static cc_s32f resampler_output[OUTPUT_SAMPLE_RATE * 2];
+static unsigned long clocks_generated;
+
+static cc_s16l SquareWave(const unsigned long clock)
+{
+	return clock / HALF_PERIOD % 2 == 0 ? AMPLITUDE : -AMPLITUDE;
+}
+
+static size_t InputCallback(void *user_data, cc_s16l *buffer, size_t total_frames)
+{
+	size_t i;
+
+	(void)user_data;
+
+	for (i = 0; i < total_frames; ++i)
+		buffer[i] = SquareWave(clocks_generated++);
+
+	return total_frames;
+}
+
+int main(void)
+{
+	size_t step_frames, resampler_frames, i;
+	unsigned long clock;
+	cc_s16l level;
+	double signal, error;
+
+	ClownResampler_Precompute(&precomputed, kernel_table, CLOWNRESAMPLER_KERNEL_RADIUS, CLOWNRESAMPLER_KERNEL_RESOLUTION);
+
+	if (ClownResampler_Step_GetBufferSize(&precomputed, 1, CLOCK_RATE, OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE / 60 + 1) > CLOWNRESAMPLER_COUNT_OF(step_buffer)
+	 || !ClownResampler_Step_Init(&step, &precomputed, 1, CLOCK_RATE, OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE, step_buffer, CLOWNRESAMPLER_COUNT_OF(step_buffer))
+	 || !ClownResampler_HighLevel_Init(&resampler, &precomputed, 1, CLOCK_RATE, OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE))
+	{
+		fputs("Failed to initialise.\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	/* Render the square wave with steps, one clock frame at a time. */
+	step_frames = 0;
+	level = 0;
+
+	for (clock = 0; clock < (unsigned long)CLOCKS_PER_FRAME * TOTAL_CLOCK_FRAMES; ++clock)
+	{
+		const cc_s16l new_level = SquareWave(clock);
+
+		if (new_level != level)
+		{
+			ClownResampler_Step_AddDelta(&step, clock % CLOCKS_PER_FRAME, 0, new_level - level);
+			level = new_level;
+		}
+
+		if (clock % CLOCKS_PER_FRAME == CLOCKS_PER_FRAME - 1)
+		{
+			ClownResampler_Step_EndFrame(&step, CLOCKS_PER_FRAME);
+			step_frames += ClownResampler_Step_ReadToS32(&step, &step_output[step_frames], CLOWNRESAMPLER_COUNT_OF(step_output) - step_frames);
+		}
+	}
+
+	/* Return to silence, and check that the output settles there exactly. */
+	ClownResampler_Step_AddDelta(&step, 0, 0, -level);
+	ClownResampler_Step_EndFrame(&step, CLOCKS_PER_FRAME);
+	step_frames += ClownResampler_Step_ReadToS32(&step, &step_output[step_frames], CLOWNRESAMPLER_COUNT_OF(step_output) - step_frames);
+
+	if (step_output[step_frames - 1] != 0)
+	{
+		fprintf(stderr, "The steps did not add up: the output ended at %ld.\n", (long)step_output[step_frames - 1]);
+		return EXIT_FAILURE;
+	}
+
+	/* Render the same square wave with the high-level API. */
+	resampler_frames = ClownResampler_HighLevel_ResampleToS32(&resampler, &precomputed, InputCallback, resampler_output, OUTPUT_SAMPLE_RATE, NULL);
+
+	/* The steps are delayed by the kernel's radius. The start is skipped, since the two differ in how they begin. */
+	signal = error = 0.0;
+
+	for (i = 0x100; i < resampler_frames - 0x100; ++i)
+	{
+		const double expected = resampler_output[i];
+		const double difference = step_output[i + step.integer_stretched_kernel_radius] - expected;
+
+		signal += expected * expected;
+		error += difference * difference;
+	}
+
+	printf("Signal-to-error ratio: %.1f\n", signal / error);
+
+	/* The high-level API filters a sampled square wave rather than an ideal one, so the two are close, but not identical. */
+	if (signal < error * 1000.0)
+	{
+		fputs("The steps do not match the resampled square wave.\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
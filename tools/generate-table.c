@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2022-2023 Clownacy
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+PERFORMANCE OF THIS SOFTWARE.
+*/
+
+/* Generates a C source file containing a const 'ClownResampler_Precomputed',
+   so that 'ClownResampler_Precompute' does not need to be called at runtime.
+   The table's layout depends on 'CLOWNRESAMPLER_SYMMETRIC_KERNEL' and
+   'CLOWNRESAMPLER_INTERPOLATE_KERNEL', so this must be built with the same
+   definitions as the code that will use the table. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CLOWNRESAMPLER_IMPLEMENTATION
+#define CLOWNRESAMPLER_NO_LOW_LEVEL_API /* We only need 'ClownResampler_Precompute'. */
+#define CLOWNRESAMPLER_NO_HIGH_LEVEL_API
+#define CLOWNRESAMPLER_NO_FLOAT_API
+#include "../clownresampler.h"
+
+static void WriteDefinitionCheck(FILE *output_file, const char *definition, cc_bool defined)
+{
+	fprintf(output_file, "#if%s %s\n#error \"This table was generated %s '%s'.\"\n#endif\n\n", defined ? "ndef" : "def", definition, defined ? "with" : "without", definition);
+}
+
+int main(int argc, char **argv)
+{
+	int exit_code = EXIT_FAILURE;
+
+	if (argc < 4)
+	{
+		fputs("Usage: generate-table [kernel radius] [kernel resolution] [output file]\n", stderr);
+	}
+	else
+	{
+		const cc_u32f kernel_radius = strtoul(argv[1], NULL, 0);
+		const cc_u32f kernel_resolution = strtoul(argv[2], NULL, 0);
+		const size_t total_entries = CLOWNRESAMPLER_KERNEL_TABLE_LENGTH((size_t)kernel_radius, kernel_resolution);
+
+		ClownResampler_KernelValue *kernel_table;
+
+		if (kernel_radius == 0 || kernel_resolution == 0)
+		{
+			fputs("The kernel radius and resolution must not be 0.\n", stderr);
+		}
+		else
+		{
+			kernel_table = (ClownResampler_KernelValue*)malloc(total_entries * sizeof(*kernel_table));
+
+			if (kernel_table == NULL)
+			{
+				fputs("Could not allocate memory for the kernel table.\n", stderr);
+			}
+			else
+			{
+				FILE *output_file = fopen(argv[3], "w");
+
+				if (output_file == NULL)
+				{
+					fputs("Could not open output file.\n", stderr);
+				}
+				else
+				{
+					ClownResampler_Precomputed precomputed;
+					size_t i;
+
+					ClownResampler_Precompute(&precomputed, kernel_table, kernel_radius, kernel_resolution);
+
+					fputs("/* Generated by generate-table.c. Do not edit. */\n\n#include \"clownresampler.h\"\n\n", output_file);
+
+				#ifdef CLOWNRESAMPLER_SYMMETRIC_KERNEL
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_SYMMETRIC_KERNEL", cc_true);
+				#else
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_SYMMETRIC_KERNEL", cc_false);
+				#endif
+				#ifdef CLOWNRESAMPLER_INTERPOLATE_KERNEL
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_INTERPOLATE_KERNEL", cc_true);
+				#else
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_INTERPOLATE_KERNEL", cc_false);
+				#endif
+				#if !defined(CLOWNRESAMPLER_SYMMETRIC_KERNEL) && !defined(CLOWNRESAMPLER_INTERPOLATE_KERNEL)
+				 #ifdef CLOWNRESAMPLER_FIXED_TAPS
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_FIXED_TAPS", cc_true);
+				 #else
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_FIXED_TAPS", cc_false);
+				 #endif
+				#endif
+				#ifdef CLOWNRESAMPLER_16_BIT_KERNEL
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_16_BIT_KERNEL", cc_true);
+				#else
+					WriteDefinitionCheck(output_file, "CLOWNRESAMPLER_16_BIT_KERNEL", cc_false);
+				#endif
+
+					fprintf(output_file, "static const ClownResampler_KernelValue kernel_table[%lu] = {", (unsigned long)total_entries);
+
+					for (i = 0; i < total_entries; ++i)
+						fprintf(output_file, "%s%ld,", i % 8 == 0 ? "\n\t" : " ", (long)kernel_table[i]);
+
+					fprintf(output_file, "\n};\n\nconst ClownResampler_Precomputed ClownResampler_builtin_precomputed = {%lu, %lu, &kernel_table[%lu]};\n", (unsigned long)kernel_radius, (unsigned long)kernel_resolution, (unsigned long)(precomputed.lanczos_kernel_table - kernel_table));
+
+					if (ferror(output_file) == 0)
+						exit_code = EXIT_SUCCESS;
+					else
+						fputs("Could not write to output file.\n", stderr);
+
+					fclose(output_file);
+				}
+
+				free(kernel_table);
+			}
+		}
+	}
+
+	return exit_code;
+}